@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Minitel1B_Canvas - Fichier source - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+   https://entropie.org/3615/
+
+   Documentation utilisée :
+   Spécifications Techniques d'Utilisation du Minitel 1B
+   http://543210.free.fr/TV/stum1b.pdf
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#include "Minitel1B_Canvas.h"
+
+#define PAVES     0b111111  // Bits des pavés dans une case
+#define MODIFIEE  0x80      // Case à envoyer au prochain flush()
+
+// Nombre maximum de cases inchangées renvoyées pour réunir deux suites de
+// cases modifiées : les sauter coûte un HT par case, ou 4 octets (CSI Pn C).
+#define ECART_MAX  3
+
+////////////////////////////////////////////////////////////////////////
+/*
+   Public
+*/
+////////////////////////////////////////////////////////////////////////
+
+MinitelCanvas::MinitelCanvas(Minitel& minitel, byte* cells, size_t size) : minitel(&minitel), cells(cells), capacite(size) {
+  zoneX = zoneY = 1;
+  colonnes = rangees = 0;  // Tableau trop petit : zone vide
+  couleurCaractere = CARACTERE_BLANC;
+  couleurFond = FOND_NOIR;
+  int n = (int) ((size < MINITEL_COLONNES) ? size : MINITEL_COLONNES);
+  if (n > 0) {
+    size_t r = size / n;
+    setArea(1, 1, n, (r < MINITEL_RANGEES-1) ? (int) r : MINITEL_RANGEES-1);
+  }
+}
+/*--------------------------------------------------------------------*/
+
+boolean MinitelCanvas::setArea(int x, int y, int columns, int rows) {
+  if (x < 1 || y < 0 || columns < 1 || rows < 1) return false;
+  if (x + columns - 1 > MINITEL_COLONNES || y + rows - 1 >= MINITEL_RANGEES) return false;
+  if ((size_t) columns * rows > capacite) return false;
+  zoneX = x;
+  zoneY = y;
+  colonnes = columns;
+  rangees = rows;
+  for (int i=0; i<colonnes*rangees; i++) {
+    cells[i] = MODIFIEE;
+  }
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelCanvas::setColors(byte caractere, byte fond) {
+  if (caractere < CARACTERE_NOIR || caractere > CARACTERE_BLANC) return;
+  if (fond < FOND_NOIR || fond > FOND_BLANC) return;
+  if (caractere != couleurCaractere || fond != couleurFond) invalidate();
+  couleurCaractere = caractere;
+  couleurFond = fond;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelCanvas::setPixel(int x, int y, boolean allume) {
+  if (x < 0 || y < 0 || x >= 2*colonnes || y >= 3*rangees) return;
+  byte& c = cells[(y/3)*colonnes + x/2];
+  byte pave = 0b100000 >> ((y%3)*2 + (x&1));
+  byte avant = c;
+  if (allume) c |= pave;
+  else c &= ~pave;
+  if (c != avant) c |= MODIFIEE;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelCanvas::clearPixel(int x, int y) {
+  setPixel(x, y, false);
+}
+/*--------------------------------------------------------------------*/
+
+boolean MinitelCanvas::getPixel(int x, int y) const {
+  if (x < 0 || y < 0 || x >= 2*colonnes || y >= 3*rangees) return false;
+  return (cells[(y/3)*colonnes + x/2] & (0b100000 >> ((y%3)*2 + (x&1)))) != 0;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelCanvas::clear() {
+  for (int i=0; i<colonnes*rangees; i++) {
+    if (cells[i] & PAVES) cells[i] = MODIFIEE;
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelCanvas::line(int x1, int y1, int x2, int y2, boolean allume) {
+  // Algorithme de Bresenham
+  int dx = abs(x2 - x1);
+  int dy = -abs(y2 - y1);
+  int sx = (x1 < x2) ? 1 : -1;
+  int sy = (y1 < y2) ? 1 : -1;
+  int erreur = dx + dy;
+  while (true) {
+    setPixel(x1, y1, allume);
+    if (x1 == x2 && y1 == y2) break;
+    int e2 = 2 * erreur;
+    if (e2 >= dy) {
+      erreur += dy;
+      x1 += sx;
+    }
+    if (e2 <= dx) {
+      erreur += dx;
+      y1 += sy;
+    }
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelCanvas::rect(int x1, int y1, int x2, int y2, boolean allume) {
+  line(x1, y1, x2, y1, allume);
+  line(x1, y2, x2, y2, allume);
+  line(x1, y1, x1, y2, allume);
+  line(x2, y1, x2, y2, allume);
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelCanvas::fillRect(int x1, int y1, int x2, int y2, boolean allume) {
+  if (x1 > x2) { int t = x1; x1 = x2; x2 = t; }
+  if (y1 > y2) { int t = y1; y1 = y2; y2 = t; }
+  if (x1 < 0) x1 = 0;
+  if (y1 < 0) y1 = 0;
+  if (x2 >= 2*colonnes) x2 = 2*colonnes - 1;
+  if (y2 >= 3*rangees) y2 = 3*rangees - 1;
+  for (int y=y1; y<=y2; y++) {
+    for (int x=x1; x<=x2; x++) {
+      setPixel(x, y, allume);
+    }
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelCanvas::blit(const byte* bitmap, int x, int y, int w, int h) {
+  blitBits(bitmap, false, x, y, w, h);
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelCanvas::blit_P(const byte* bitmap, int x, int y, int w, int h) {
+  blitBits(bitmap, true, x, y, w, h);
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelCanvas::flush() {
+  minitel->holdFlush();  // Tout part d'un bloc
+  for (int r=0; r<rangees; r++) {
+    byte* rangee = cells + r*colonnes;
+    int c = 0;
+    while (c < colonnes) {
+      if (!(rangee[c] & MODIFIEE)) {
+        c++;
+        continue;
+      }
+      // Suite de cases modifiées, prolongée tant que les cases inchangées
+      // qui la séparent de la suivante sont peu nombreuses.
+      int debut = c;
+      int fin = c;
+      int ecart = 0;
+      for (int k=c+1; k<colonnes; k++) {
+        if (rangee[k] & MODIFIEE) {
+          fin = k;
+          ecart = 0;
+        }
+        else if (++ecart > ECART_MAX) {
+          break;
+        }
+      }
+      if (zoneY + r == 0) {
+        minitel->newXY(zoneX + debut, 0);  // Rangée 0 : US seulement (voir p.96)
+      }
+      else {
+        minitel->moveCursorXY(zoneX + debut, zoneY + r);
+      }
+      // Attributs déjà en vigueur : rien n'est envoyé (voir Minitel::attributs).
+      minitel->graphicMode();
+      minitel->attributs(couleurCaractere);
+      minitel->attributs(couleurFond);  // Validé par chaque caractère semi-graphique
+      minitel->attributs(FIXE);
+      minitel->attributs(FIN_LIGNAGE);  // Semi-graphiques joints
+      for (int k=debut; k<=fin; k++) {
+        rangee[k] &= PAVES;
+        minitel->writeByte(Minitel::getGraphicByte(rangee[k]));  // Suites identiques codées par REP
+      }
+      c = fin + 1;
+    }
+  }
+  minitel->releaseFlush();
+  minitel->flush();
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelCanvas::invalidate() {
+  for (int i=0; i<colonnes*rangees; i++) {
+    cells[i] |= MODIFIEE;
+  }
+}
+/*--------------------------------------------------------------------*/
+
+
+////////////////////////////////////////////////////////////////////////
+/*
+   Private
+*/
+////////////////////////////////////////////////////////////////////////
+
+void MinitelCanvas::blitBits(const byte* bitmap, boolean flash, int x, int y, int w, int h) {
+  int parLigne = (w + 7) / 8;
+  for (int j=0; j<h; j++) {
+    for (int i=0; i<w; i++) {
+      const byte* p = bitmap + j * parLigne + i / 8;
+      byte octet = flash ? pgm_read_byte(p) : *p;
+      setPixel(x + i, y + j, (octet & (0x80 >> (i % 8))) != 0);
+    }
+  }
+}
+/*--------------------------------------------------------------------*/
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Minitel1B_Canvas - Fichier d'en-tête - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+   https://entropie.org/3615/
+
+   Zone de dessin en pixels sur les caractères semi-graphiques du jeu G1 :
+   chaque case de l'écran est un bloc de 2 x 3 pavés, soit 80 x 72 pixels
+   pour les rangées 1 à 24 (80 x 75 avec la rangée 0).
+
+   Les pixels sont rangés dans un tableau fourni par l'appelant, à raison
+   d'un octet par case de la zone (6 bits pour les pavés, 1 bit pour
+   « modifiée »). Mémoire vive d'un MinitelCanvas : ce tableau (960 octets
+   pour l'écran entier, 200 pour une zone de 20 x 10 cases) plus 16 octets
+   sur AVR. flush() n'envoie que les cases modifiées depuis le flush()
+   précédent, par suites de cases voisines : une jauge ou une courbe qui
+   change de quelques pixels coûte quelques octets.
+
+   Documentation utilisée :
+   Spécifications Techniques d'Utilisation du Minitel 1B
+   http://543210.free.fr/TV/stum1b.pdf
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#ifndef MINITEL1B_CANVAS_H
+#define MINITEL1B_CANVAS_H
+
+#include "Minitel1B_Screen.h"
+
+////////////////////////////////////////////////////////////////////////
+
+class MinitelCanvas
+{
+public:
+  // cells : un octet par case de la zone, size octets en tout. La zone
+  // par défaut part de 1, 1 sur 40 colonnes et autant de rangées (24 au
+  // plus) que le tableau en contient.
+  MinitelCanvas(Minitel& minitel, byte* cells, size_t size);
+
+  // Zone
+  boolean setArea(int x, int y, int columns, int rows);  // Cases occupées. Efface le dessin. false si la zone sort de l'écran ou du tableau.
+  int width() const { return 2 * colonnes; }   // En pixels
+  int height() const { return 3 * rangees; }
+  void setColors(byte caractere, byte fond);  // CARACTERE_NOIR à CARACTERE_BLANC pour les pixels allumés, FOND_NOIR à FOND_BLANC pour les autres
+
+  // Dessin (rien n'est envoyé au Minitel avant flush). Pixel x de 0 à
+  // width()-1, de gauche à droite, et y de 0 à height()-1, de haut en bas.
+  // Ce qui sort de la zone est ignoré.
+  void setPixel(int x, int y, boolean allume = true);
+  void clearPixel(int x, int y);
+  boolean getPixel(int x, int y) const;
+  void clear();  // Tous les pixels éteints
+  void line(int x1, int y1, int x2, int y2, boolean allume = true);
+  void rect(int x1, int y1, int x2, int y2, boolean allume = true);  // Contour
+  void fillRect(int x1, int y1, int x2, int y2, boolean allume = true);
+  // Image de 1 bit par pixel, ligne par ligne, bit de poids fort à gauche,
+  // chaque ligne commençant sur un nouvel octet. Les bits à 0 éteignent
+  // les pixels : l'image remplace ce qui était dessous.
+  void blit(const byte* bitmap, int x, int y, int w, int h);
+  void blit_P(const byte* bitmap, int x, int y, int w, int h);  // Image en mémoire flash (PROGMEM)
+
+  // Envoi
+  void flush();  // Envoie les cases modifiées depuis le flush() précédent.
+  void invalidate();  // Le contenu du Minitel est inconnu : le prochain flush() renvoie toute la zone.
+
+private:
+  Minitel* minitel;
+  byte* cells;  // Pavés (bits 0 à 5, voir Minitel::graphic) et drapeau « modifiée », rangée par rangée
+  size_t capacite;  // Taille de cells
+  int zoneX, zoneY, colonnes, rangees;
+  byte couleurCaractere, couleurFond;
+
+  void blitBits(const byte* bitmap, boolean flash, int x, int y, int w, int h);
+};
+
+////////////////////////////////////////////////////////////////////////
+
+#endif  // Fin Si (MINITEL1B_CANVAS_H)
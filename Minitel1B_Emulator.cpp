@@ -0,0 +1,809 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Minitel1B_Emulator - Fichier source - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+   https://entropie.org/3615/
+
+   Documentation utilisée :
+   Spécifications Techniques d'Utilisation du Minitel 1B
+   http://543210.free.fr/TV/stum1b.pdf
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#if !defined(ARDUINO)  // Uniquement en dehors de l'environnement Arduino
+
+#include "Minitel1B_Emulator.h"
+
+// Etats de l'analyse du flux reçu
+#define FLUX_NORMAL       0
+#define FLUX_ESC          1
+#define FLUX_CSI          2
+#define FLUX_US           3
+#define FLUX_US2          4
+#define FLUX_SS2          5
+#define FLUX_DIACRITIQUE  6
+#define FLUX_REP          7
+#define FLUX_SEP          8
+#define FLUX_PRO          9
+
+// Octet de vitesse des commandes PROG et des réponses (voir p.141)
+static byte octetVitesse(long bauds) {
+  switch (bauds) {
+    case  300 : return 0x52;
+    case 4800 : return 0x76;
+    case 9600 : return 0x7F;
+  }
+  return 0x64;  // 1200 bauds
+}
+
+// Case effacée : espace blanc sur fond noir
+static MinitelCell caseVide() {
+  MinitelCell c;
+  c.code = SP;
+  c.diacritic = 0;
+  c.set = JEU_G0;
+  c.color = CARACTERE_BLANC - CARACTERE_NOIR;
+  c.background = 0;
+  c.size = 0;
+  c.blink = 0;
+  c.mask = 0;
+  c.underline = 0;
+  c.inverse = 0;
+  return c;
+}
+
+// Unicode => UTF-8
+static void ajouterUtf8(std::string& s, unsigned long u) {
+  if (u < 0x80) {
+    s += (char) u;
+  }
+  else if (u < 0x800) {
+    s += (char) (0xC0 | (u >> 6));
+    s += (char) (0x80 | (u & 0x3F));
+  }
+  else if (u < 0x10000) {
+    s += (char) (0xE0 | (u >> 12));
+    s += (char) (0x80 | ((u >> 6) & 0x3F));
+    s += (char) (0x80 | (u & 0x3F));
+  }
+  else {
+    s += (char) (0xF0 | (u >> 18));
+    s += (char) (0x80 | ((u >> 12) & 0x3F));
+    s += (char) (0x80 | ((u >> 6) & 0x3F));
+    s += (char) (0x80 | (u & 0x3F));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////
+/*
+   Public
+*/
+////////////////////////////////////////////////////////////////////////
+
+MinitelEmulator::MinitelEmulator() : vitesse(1200), ligne(1200), parite(false) {
+  reset();
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelEmulator::begin(long bauds) {
+  ligne = bauds;
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+int MinitelEmulator::available() {
+  return (int) reponses.size();
+}
+/*--------------------------------------------------------------------*/
+
+int MinitelEmulator::read() {
+  if (reponses.empty()) return -1;
+  uint8_t b = reponses.front();
+  reponses.pop_front();
+  return b;
+}
+/*--------------------------------------------------------------------*/
+
+size_t MinitelEmulator::write(const uint8_t *buffer, size_t size) {
+  if (ligne == vitesse) receive(buffer, size);
+  return size;
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelEmulator::nativeParity(bool actif) {
+  parite = actif;
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::reset() {
+  colonnes = MINITEL_COLONNES;
+  rouleau = false;
+  insertion = false;
+  minuscules = false;
+  clavierEtendu = false;
+  curseurVisible = false;
+  bips = 0;
+  liaisons[0] = 0x04;  // Ecran <= modem
+  liaisons[1] = 0x00;
+  liaisons[2] = 0x02;  // Modem <= clavier
+  liaisons[3] = 0x00;
+  etat = FLUX_NORMAL;
+  dernier[0] = 0;
+  separator();
+  clearRows(0, MINITEL_RANGEES-1);
+  curseurX = 1;
+  curseurY = 1;
+  sauveX = 1;
+  sauveY = 1;
+  sauveStylo = stylo;
+  sauveGraphique = false;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::receive(const byte* buffer, size_t size) {
+  for (size_t i=0; i<size; i++) receive(buffer[i]);
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::receive(byte b) {
+  b &= 0x7F;
+  switch (etat) {
+    case FLUX_ESC :
+      if (b >= 0x20 && b <= 0x2F) {  // Octet intermédiaire (ESC 0x23 0x20 0x58...)
+        intermediaire = b;
+        return;
+      }
+      etat = FLUX_NORMAL;
+      if (intermediaire != 0) return;  // Séquence non traitée
+      if (b == 0x5B) {  // CSI
+        etat = FLUX_CSI;
+        nbParametres = 0;
+        parametres[0] = parametres[1] = 0;
+      }
+      else if (b >= 0x39 && b <= 0x3B) {  // PRO1, PRO2, PRO3
+        etat = FLUX_PRO;
+        nbPro = 0;
+        attendusPro = b - 0x38;
+      }
+      else if (b == 0x61) {  // Demande de position du curseur (voir p.98)
+        byte trame[3] = { US, (byte) (0x40 + curseurY), (byte) (0x40 + curseurX) };
+        reply(trame, 3);
+      }
+      else if (b >= 0x40 && b <= 0x5F) {
+        attribute(b);
+      }
+      return;
+    case FLUX_CSI :
+      if (b >= 0x30 && b <= 0x39) {
+        if (nbParametres == 0) nbParametres = 1;
+        int& p = parametres[nbParametres-1];
+        if (p < 1000) p = p*10 + (b - 0x30);
+        return;
+      }
+      if (b == 0x3B) {
+        if (nbParametres == 0) nbParametres = 1;
+        if (nbParametres < 2) nbParametres++;
+        return;
+      }
+      if (b == 0x3F) {  // CSI ? : séquences privées, ignorées
+        intermediaire = b;
+        return;
+      }
+      etat = FLUX_NORMAL;
+      if (intermediaire == 0) csi(b);
+      else if (intermediaire == 0x3F && b == 0x7B) {  // Retour au standard Télétel
+        byte trame[2] = { 0x13, 0x5E };
+        reply(trame, 2);
+      }
+      return;
+    case FLUX_US :
+      etat = FLUX_US2;
+      rangeeUS = b;
+      return;
+    case FLUX_US2 :
+      etat = FLUX_NORMAL;
+      if (rangeeUS >= 0x40 && rangeeUS <= 0x40 + MINITEL_RANGEES-1 && b > 0x40 && b <= 0x40 + colonnes) {
+        int y = rangeeUS - 0x40;
+        if (y == 0 && curseurY != 0) {  // Entrée en rangée 0 : LF ramènera ici
+          sauveX = curseurX;
+          sauveY = curseurY;
+          sauveStylo = stylo;
+          sauveGraphique = graphique;
+        }
+        separator();
+        curseurX = b - 0x40;
+        curseurY = y;
+      }
+      return;
+    case FLUX_SS2 :
+      etat = FLUX_NORMAL;
+      if (b >= 0x40 && b <= 0x4F) {  // Diacritique : il se combine avec la lettre qui suit.
+        etat = FLUX_DIACRITIQUE;
+        diacritique = b;
+      }
+      else if (b >= SP) {
+        put(b, 0, JEU_G2);
+      }
+      return;
+    case FLUX_DIACRITIQUE :
+      etat = FLUX_NORMAL;
+      if (b >= SP) put(b, diacritique, JEU_G2);
+      return;
+    case FLUX_REP :
+      etat = FLUX_NORMAL;
+      if (b >= 0x40 && dernier[0] != 0) {
+        for (int i=0; i<b-0x40; i++) put(dernier[0], dernier[1], dernier[2]);
+      }
+      return;
+    case FLUX_SEP :
+      etat = FLUX_NORMAL;
+      return;
+    case FLUX_PRO :
+      pro[nbPro++] = b;
+      if (nbPro == attendusPro) {
+        etat = FLUX_NORMAL;
+        protocol();
+      }
+      return;
+  }
+  if (b >= SP) {
+    put(b, 0, graphique ? JEU_G1 : JEU_G0);
+    return;
+  }
+  switch (b) {
+    case ESC : etat = FLUX_ESC; intermediaire = 0; break;
+    case US  : etat = FLUX_US; break;
+    case SS2 : etat = FLUX_SS2; break;
+    case REP : etat = FLUX_REP; break;
+    case 0x13 : etat = FLUX_SEP; break;
+    case SO  : graphique = true; break;
+    case SI  : graphique = false; break;
+    case CON : curseurVisible = true; break;
+    case COFF : curseurVisible = false; break;
+    case BEL : bips++; break;
+    case BS :
+      if (curseurX > 1) curseurX--;
+      else if (curseurY != 0) {
+        curseurX = colonnes;
+        lineUp();
+      }
+      break;
+    case HT :
+      if (curseurX < colonnes) curseurX++;
+      else if (curseurY != 0) {
+        curseurX = 1;
+        lineFeed();
+      }
+      break;
+    case LF : lineFeed(); break;
+    case VT : lineUp(); break;
+    case CR : curseurX = 1; break;
+    case RS :
+      separator();
+      curseurX = 1;
+      curseurY = 1;
+      break;
+    case FF :  // La rangée 0 n'est pas effacée.
+      separator();
+      clearRows(1, MINITEL_RANGEES-1);
+      curseurX = 1;
+      curseurY = 1;
+      break;
+    case CAN : {  // Espaces jusqu'à la fin de la rangée, sans déplacer le curseur
+      int x = curseurX;
+      int y = curseurY;
+      bool ins = insertion;
+      insertion = false;
+      while (curseurY == y) {
+        int avant = curseurX;
+        put(SP, 0, graphique ? JEU_G1 : JEU_G0);
+        if (curseurX <= avant) break;  // Fin de rangée
+      }
+      insertion = ins;
+      curseurX = x;
+      curseurY = y;
+      break;
+    }
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::pressKey(unsigned long code) {
+  byte trame[4];
+  size_t n = 0;
+  for (int decalage=24; decalage>=0; decalage-=8) {
+    byte b = (byte) (code >> decalage);
+    if (b != 0 || n > 0 || decalage == 0) trame[n++] = b;
+  }
+  reply(trame, n);
+}
+/*--------------------------------------------------------------------*/
+
+MinitelCell MinitelEmulator::getCell(int x, int y) const {
+  if (x >= 1 && x <= colonnes && y >= 0 && y < MINITEL_RANGEES) {
+    return cases[y][x-1];
+  }
+  return cases[0][0];
+}
+/*--------------------------------------------------------------------*/
+
+std::string MinitelEmulator::row(int y) const {
+  std::string s;
+  if (y < 0 || y >= MINITEL_RANGEES) return s;
+  for (int x=0; x<colonnes; x++) {
+    const MinitelCell& c = cases[y][x];
+    if (c.code == 0) {  // Case recouverte par un caractère double
+      // La moitié droite d'un caractère en double largeur disparaît : le
+      // caractère UTF-8 la représente déjà. Sinon, un espace.
+      if (x == 0 || cases[y][x-1].code == 0 || !(cases[y][x-1].size & 0b10)) s += ' ';
+      continue;
+    }
+    unsigned long u = c.code;
+    if (c.set == JEU_G1 && (c.code < 0x40 || c.code >= 0x5F)) {
+      // Semi-graphique : 6 pavés, bit 0 en haut à gauche (voir getGraphicByte)
+      byte pave = (c.code & 0x1F) | ((c.code & 0x40) ? 0x20 : 0);
+      if (pave == 0) u = ' ';
+      else if (pave == 0x3F) u = 0x2588;  // █
+      else if (pave == 0x15) u = 0x258C;  // ▌
+      else if (pave == 0x2A) u = 0x2590;  // ▐
+      else u = 0x1FB00 + pave - 1 - (pave > 0x15) - (pave > 0x2A);  // Sextants Unicode
+    }
+    else if (c.set == JEU_G2) {
+      unsigned long code = (c.diacritic != 0) ? (((unsigned long) SS2 << 16) | (c.diacritic << 8) | c.code) : (((unsigned long) SS2 << 8) | c.code);
+      u = MinitelTranscoder::unicodeCode(code);
+      if (u == 0) u = (c.diacritic != 0) ? c.code : '?';
+    }
+    else if (c.code == 0x5E || c.code == 0x60) {
+      u = MinitelTranscoder::unicodeCode(c.code);  // ↑ et —
+    }
+    else if (c.code >= 0x7B && c.code <= 0x7E) {  // Filets (voir hLine et vLine)
+      static const unsigned int FILETS[4] = { 0x258F, 0x2502, 0x2595, 0x203E };  // ▏ │ ▕ ‾
+      u = FILETS[c.code - 0x7B];
+    }
+    else if (c.code == 0x7F) {
+      u = 0x2588;  // Pavé plein
+    }
+    ajouterUtf8(s, u);
+  }
+  return s;
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelEmulator::sameScreen(const MinitelEmulator& autre) const {
+  if (colonnes != autre.colonnes || curseurX != autre.curseurX || curseurY != autre.curseurY
+      || curseurVisible != autre.curseurVisible || bips != autre.bips) return false;
+  for (int y=0; y<MINITEL_RANGEES; y++) {
+    for (int x=0; x<colonnes; x++) {
+      if (cases[y][x] != autre.cases[y][x]) return false;
+    }
+  }
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+std::vector<byte> MinitelEmulator::optimize(const byte* page, size_t size) {
+  std::vector<byte> original(page, page + size);
+  if (size == 0 || (page[0] & 0x7F) != FF) return original;  // Ecran de départ inconnu
+  MinitelEmulator avant;
+  avant.receive(page, size);
+  if (avant.colonnes != MINITEL_COLONNES || avant.rouleau) return original;
+  // L'écran obtenu est recopié dans un écran virtuel. Les cases recouvertes
+  // par un caractère double sont vides : le caractère double les recouvrira.
+  MinitelMemoryTransport sortie;
+  Minitel minitel(sortie);
+  minitel.setNativeParity(true);  // Octets de 7 bits, comme la page d'origine
+  MinitelScreen ecran(minitel);
+  for (int y=0; y<MINITEL_RANGEES; y++) {
+    for (int x=1; x<=MINITEL_COLONNES; x++) {
+      MinitelCell c = avant.cases[y][x-1];
+      if (c.code == 0) c = caseVide();
+      ecran.setCell(x, y, c);
+    }
+  }
+  minitel.setAutoFlush(MINITEL_TX_BUFFER_SIZE);
+  ecran.commit();
+  // Etat final : bips, position et visibilité du curseur
+  for (unsigned long i=0; i<avant.bips; i++) minitel.bip();
+  if (avant.curseurY == 0) {
+    minitel.newXY(avant.curseurX, 0);
+  }
+  else {
+    minitel.moveCursorXY(avant.curseurX, avant.curseurY);
+  }
+  if (avant.curseurVisible) minitel.cursor();
+  minitel.flush();
+  const std::vector<uint8_t>& resultat = sortie.output();
+  // Vérification
+  MinitelEmulator apres;
+  apres.receive(resultat.data(), resultat.size());
+  if (resultat.size() >= size || !apres.sameScreen(avant)) return original;
+  return std::vector<byte>(resultat.begin(), resultat.end());
+}
+/*--------------------------------------------------------------------*/
+
+std::string MinitelEmulator::text() const {
+  std::string s;
+  for (int y=0; y<MINITEL_RANGEES; y++) {
+    s += row(y);
+    s += '\n';
+  }
+  return s;
+}
+/*--------------------------------------------------------------------*/
+
+
+
+
+////////////////////////////////////////////////////////////////////////
+/*
+   Private
+*/
+////////////////////////////////////////////////////////////////////////
+
+void MinitelEmulator::clearCells(int y, int x1, int x2) {
+  MinitelCell vide = caseVide();
+  for (int x=x1; x<=x2; x++) cases[y][x-1] = vide;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::clearRows(int y1, int y2) {
+  for (int y=y1; y<=y2; y++) clearCells(y, 1, MINITEL_COLONNES_MIXTE);
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::put(byte code, byte diacritic, byte set) {
+  dernier[0] = code;
+  dernier[1] = diacritic;
+  dernier[2] = set;
+  MinitelCell c = stylo;
+  c.code = code;
+  c.diacritic = diacritic;
+  c.set = set;
+  if (set == JEU_G1) {
+    // Tout caractère semi-graphique est un délimiteur. Taille et
+    // inversion ne s'appliquent pas ; le lignage donne le mode disjoint.
+    fond = stylo.background;
+    masquage = stylo.mask;
+    lignage = stylo.underline;
+    c.size = 0;
+    c.inverse = 0;
+  }
+  else {
+    if (set == JEU_G0 && code == SP) {  // L'espace est un délimiteur.
+      fond = stylo.background;
+      masquage = stylo.mask;
+      lignage = stylo.underline;
+    }
+    c.background = fond;
+    c.mask = masquage;
+    c.underline = lignage;
+    // Pas de double hauteur en rangées 0 et 1, ni de double largeur en
+    // dernière colonne, ni de doubles tailles en mode Mixte.
+    if (colonnes == MINITEL_COLONNES_MIXTE) c.size = 0;
+    if (curseurY <= 1) c.size &= 0b10;
+    if (curseurX == colonnes) c.size &= 0b01;
+  }
+  int largeur = (c.size & 0b10) ? 2 : 1;
+  MinitelCell* rangee = cases[curseurY];
+  if (insertion) {
+    for (int x=colonnes-1; x>=curseurX-1+largeur; x--) rangee[x] = rangee[x-largeur];
+  }
+  rangee[curseurX-1] = c;
+  MinitelCell moitie = c;
+  moitie.code = 0;
+  if (largeur == 2) rangee[curseurX] = moitie;
+  if (c.size & 0b01) {  // Double hauteur : le caractère déborde sur la rangée du dessus.
+    cases[curseurY-1][curseurX-1] = moitie;
+    if (largeur == 2) cases[curseurY-1][curseurX] = moitie;
+  }
+  // Avance du curseur
+  curseurX += largeur;
+  if (curseurX > colonnes) {
+    if (curseurY == 0) {
+      curseurX = colonnes;  // Pas de passage à la rangée suivante en rangée 0
+    }
+    else {
+      curseurX = 1;
+      lineFeed();
+    }
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::moveTo(int x, int y) {
+  if (y != curseurY) {  // Changement de rangée : attributs de zone par défaut
+    fond = 0;
+    masquage = 0;
+    lignage = 0;
+  }
+  curseurX = x;
+  curseurY = y;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::lineFeed() {
+  if (curseurY == 0) {  // Retour à la position et aux attributs d'avant la rangée 0
+    stylo = sauveStylo;
+    graphique = sauveGraphique;
+    moveTo(sauveX, sauveY);
+  }
+  else if (curseurY < MINITEL_RANGEES-1) {
+    moveTo(curseurX, curseurY + 1);
+  }
+  else if (rouleau) {
+    scroll(1, MINITEL_RANGEES-1, 1);
+    moveTo(curseurX, 0);  // Nouvelle rangée...
+    curseurY = MINITEL_RANGEES-1;  // ...au même endroit
+  }
+  else {
+    moveTo(curseurX, 1);
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::lineUp() {
+  if (curseurY == 0) return;
+  if (curseurY > 1) {
+    moveTo(curseurX, curseurY - 1);
+  }
+  else if (rouleau) {
+    scroll(1, MINITEL_RANGEES-1, -1);
+    moveTo(curseurX, 0);
+    curseurY = 1;
+  }
+  else {
+    moveTo(curseurX, MINITEL_RANGEES-1);
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::scroll(int y1, int y2, int n) {
+  // Décale les rangées y1 à y2 de n rangées vers le haut (n > 0) ou vers le bas
+  if (n > 0) {
+    for (int y=y1; y<=y2; y++) {
+      if (y + n <= y2) {
+        for (int x=0; x<MINITEL_COLONNES_MIXTE; x++) cases[y][x] = cases[y+n][x];
+      }
+      else clearRows(y, y);
+    }
+  }
+  else if (n < 0) {
+    for (int y=y2; y>=y1; y--) {
+      if (y + n >= y1) {
+        for (int x=0; x<MINITEL_COLONNES_MIXTE; x++) cases[y][x] = cases[y+n][x];
+      }
+      else clearRows(y, y);
+    }
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::separator() {
+  // US, RS et FF : tous les attributs reprennent leur valeur par défaut (voir p.96)
+  stylo = caseVide();
+  fond = 0;
+  masquage = 0;
+  lignage = 0;
+  graphique = false;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::attribute(byte b) {
+  // Grille C1 (voir p.91)
+  if (b >= CARACTERE_NOIR && b <= CARACTERE_BLANC) stylo.color = b - CARACTERE_NOIR;
+  else if (b >= FOND_NOIR && b <= FOND_BLANC) stylo.background = b - FOND_NOIR;
+  else if (b >= GRANDEUR_NORMALE && b <= DOUBLE_GRANDEUR) { if (!graphique) stylo.size = b - GRANDEUR_NORMALE; }
+  else {
+    switch (b) {
+      case CLIGNOTEMENT   : stylo.blink = 1; break;
+      case FIXE           : stylo.blink = 0; break;
+      case MASQUAGE       : stylo.mask = 1; break;
+      case DEMASQUAGE     : stylo.mask = 0; break;
+      case DEBUT_LIGNAGE  : stylo.underline = 1; break;
+      case FIN_LIGNAGE    : stylo.underline = 0; break;
+      case INVERSION_FOND : if (!graphique) stylo.inverse = 1; break;
+      case FOND_NORMAL    : if (!graphique) stylo.inverse = 0; break;
+    }
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::csi(byte final) {
+  // Fonctions de la norme ISO 6429 (voir p.95 à 97)
+  int p1 = parametres[0];
+  int p2 = parametres[1];
+  int n = (p1 > 0) ? p1 : 1;
+  int derniere = MINITEL_RANGEES-1;
+  switch (final) {
+    case 0x41 :  // A : haut
+      if (curseurY > 0) moveTo(curseurX, (curseurY - n > 1) ? curseurY - n : 1);
+      break;
+    case 0x42 :  // B : bas
+      if (curseurY > 0) moveTo(curseurX, (curseurY + n < derniere) ? curseurY + n : derniere);
+      break;
+    case 0x43 :  // C : droite
+      curseurX = (curseurX + n < colonnes) ? curseurX + n : colonnes;
+      break;
+    case 0x44 :  // D : gauche
+      curseurX = (curseurX - n > 1) ? curseurX - n : 1;
+      break;
+    case 0x48 : {  // H : adressage absolu
+      int y = (p1 < 1) ? 1 : (p1 > derniere) ? derniere : p1;
+      int x = (p2 < 1) ? 1 : (p2 > colonnes) ? colonnes : p2;
+      moveTo(x, y);
+      break;
+    }
+    case 0x4A :  // J : effacement dans l'écran
+      if (p1 == 0) {
+        clearCells(curseurY, curseurX, colonnes);
+        if (curseurY > 0) clearRows(curseurY + 1, derniere);
+      }
+      else if (p1 == 1) {
+        if (curseurY > 0) clearRows(1, curseurY - 1);
+        clearCells(curseurY, 1, curseurX);
+      }
+      else if (p1 == 2) {
+        clearRows(1, derniere);
+      }
+      break;
+    case 0x4B :  // K : effacement dans la rangée
+      if (p1 == 0) clearCells(curseurY, curseurX, colonnes);
+      else if (p1 == 1) clearCells(curseurY, 1, curseurX);
+      else if (p1 == 2) clearCells(curseurY, 1, colonnes);
+      break;
+    case 0x50 : {  // P : suppression de n caractères
+      MinitelCell* rangee = cases[curseurY];
+      for (int x=curseurX-1; x<colonnes; x++) {
+        if (x + n < colonnes) rangee[x] = rangee[x+n];
+        else clearCells(curseurY, x+1, x+1);
+      }
+      break;
+    }
+    case 0x40 : {  // @ : insertion de n espaces
+      MinitelCell* rangee = cases[curseurY];
+      for (int x=colonnes-1; x>=curseurX-1; x--) {
+        if (x - n >= curseurX-1) rangee[x] = rangee[x-n];
+        else clearCells(curseurY, x+1, x+1);
+      }
+      break;
+    }
+    case 0x4D :  // M : suppression de n rangées
+      if (curseurY > 0) scroll(curseurY, derniere, n);
+      break;
+    case 0x4C :  // L : insertion de n rangées
+      if (curseurY > 0) scroll(curseurY, derniere, -n);
+      break;
+    case 0x68 :  // h : début d'insertion de caractères
+      if (p1 == 4) insertion = true;
+      break;
+    case 0x6C :  // l : fin d'insertion de caractères
+      if (p1 == 4) insertion = false;
+      break;
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::protocol() {
+  // Commandes du protocole (voir p.134 à 145). Les réponses sont celles
+  // qu'attend Minitel1B_Soft.
+  byte trame[5];
+  switch (attendusPro) {
+    case 1 :
+      switch (pro[0]) {
+        case STATUS_VITESSE :
+          trame[0] = ESC; trame[1] = 0x3A; trame[2] = 0x75; trame[3] = octetVitesse(vitesse);
+          reply(trame, 4);
+          break;
+        case ENQROM :  // Telic-Alcatel, Minitel 1 Bistandard
+          trame[0] = 0x01; trame[1] = 0x43; trame[2] = 0x75; trame[3] = 0x3B; trame[4] = 0x04;
+          reply(trame, 5);
+          break;
+        case 0x72 :  // STATUS_FONCTIONNEMENT
+          trame[0] = ESC; trame[1] = 0x3A; trame[2] = 0x73; trame[3] = statusByte();
+          reply(trame, 4);
+          break;
+        case CONNEXION :
+        case DECONNEXION :
+          trame[0] = 0x13; trame[1] = (pro[0] == CONNEXION) ? 0x53 : 0x54;
+          reply(trame, 2);
+          break;
+        case RESET : {
+          long v = vitesse;
+          reset();
+          vitesse = v;
+          trame[0] = 0x13; trame[1] = 0x5E;
+          reply(trame, 2);
+          break;
+        }
+      }
+      break;
+    case 2 :
+      if (pro[0] == PROG) {
+        switch (pro[1]) {
+          case 0x52 : vitesse = 300; break;
+          case 0x64 : vitesse = 1200; break;
+          case 0x76 : vitesse = 4800; break;
+          case 0x7F : vitesse = 9600; break;
+        }
+        trame[0] = ESC; trame[1] = 0x3A; trame[2] = 0x75; trame[3] = octetVitesse(vitesse);
+        reply(trame, 4);
+      }
+      else if ((pro[0] == START || pro[0] == STOP) && (pro[1] == ROULEAU || pro[1] == MINUSCULES)) {
+        if (pro[1] == ROULEAU) rouleau = (pro[0] == START);
+        else minuscules = (pro[0] == START);
+        trame[0] = ESC; trame[1] = 0x3A; trame[2] = 0x73; trame[3] = statusByte();
+        reply(trame, 4);
+      }
+      else if (pro[0] == 0x32 && (pro[1] == 0x7D || pro[1] == 0x7E)) {  // MIXTE1 ou MIXTE2
+        colonnes = (pro[1] == 0x7D) ? MINITEL_COLONNES_MIXTE : MINITEL_COLONNES;
+        separator();
+        clearRows(0, MINITEL_RANGEES-1);
+        curseurX = 1;
+        curseurY = 1;
+        trame[0] = 0x13; trame[1] = (pro[1] == 0x7D) ? 0x70 : 0x71;
+        reply(trame, 2);
+      }
+      else if (pro[0] == 0x31 && pro[1] == 0x7D) {  // TELINFO : seul l'acquittement est émulé
+        trame[0] = ESC; trame[1] = 0x5B; trame[2] = 0x3F; trame[3] = 0x7A;
+        reply(trame, 4);
+      }
+      else if (pro[0] == TO && pro[1] >= CODE_EMISSION_ECRAN && pro[1] <= CODE_RECEPTION_PRISE) {
+        trame[0] = ESC; trame[1] = 0x3B; trame[2] = FROM; trame[3] = pro[1];
+        trame[4] = 0x40 | ((pro[1] >= CODE_RECEPTION_ECRAN) ? liaisons[pro[1] - CODE_RECEPTION_ECRAN] : 0);
+        reply(trame, 5);
+      }
+      break;
+    case 3 :
+      if ((pro[0] == AIGUILLAGE_ON || pro[0] == AIGUILLAGE_OFF)
+          && pro[1] >= CODE_RECEPTION_ECRAN && pro[1] <= CODE_RECEPTION_PRISE
+          && pro[2] >= CODE_EMISSION_ECRAN && pro[2] <= CODE_EMISSION_PRISE) {
+        byte& l = liaisons[pro[1] - CODE_RECEPTION_ECRAN];
+        byte bit = 1 << (pro[2] - CODE_EMISSION_ECRAN);
+        if (pro[0] == AIGUILLAGE_ON) l |= bit;
+        else l &= ~bit;
+        trame[0] = ESC; trame[1] = 0x3B; trame[2] = FROM; trame[3] = pro[1]; trame[4] = 0x40 | l;
+        reply(trame, 5);
+      }
+      else if ((pro[0] == START || pro[0] == STOP) && pro[1] == CODE_RECEPTION_CLAVIER && pro[2] == ETEN) {
+        clavierEtendu = (pro[0] == START);
+        trame[0] = ESC; trame[1] = 0x3B; trame[2] = 0x73; trame[3] = CODE_RECEPTION_CLAVIER;
+        trame[4] = 0x40 | (clavierEtendu ? 0x01 : 0);
+        reply(trame, 5);
+      }
+      break;
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelEmulator::reply(const byte* buffer, size_t size) {
+  for (size_t i=0; i<size; i++) {
+    byte b = buffer[i] & 0x7F;
+    if (!parite && (__builtin_popcount(b) & 1)) b |= 0x80;  // Parité paire
+    reponses.push_back(b);
+  }
+}
+/*--------------------------------------------------------------------*/
+
+byte MinitelEmulator::statusByte() const {
+  // Statut de fonctionnement : ME PC RL F (voir p.143)
+  return 0x40 | (minuscules ? 0x08 : 0) | (rouleau ? 0x02 : 0) | ((colonnes == MINITEL_COLONNES_MIXTE) ? 0x01 : 0);
+}
+/*--------------------------------------------------------------------*/
+
+#endif  // Fin Si (!defined(ARDUINO))
@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Minitel1B_Emulator - Fichier d'en-tête - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+   https://entropie.org/3615/
+
+   Emulateur de l'écran d'un Minitel 1B, sans affichage (Linux seulement).
+   Il interprète le flux d'octets émis par la bibliothèque (ou lu dans
+   une page Vidéotex enregistrée) et tient à jour une grille de cases
+   MinitelCell, comme le ferait le Minitel : on peut ainsi vérifier ce
+   qui serait affiché sans Minitel sous la main.
+
+   C'est aussi un MinitelTransport : Minitel minitel(emulateur) écrit
+   directement sur l'écran émulé, qui répond aux commandes du protocole
+   (vitesse, mode rouleau, position du curseur, identification...).
+
+   Modèle retenu pour les attributs de zone (fond, masquage, lignage) :
+   validés par un délimiteur (voir p.93), ils s'appliquent aux caractères
+   écrits ensuite sur la même rangée, sans modifier ceux déjà affichés.
+   Tout changement de rangée les remet à leur valeur par défaut.
+
+   Exemple de compilation :
+   g++ -O2 -I. Minitel1B_Soft.cpp Minitel1B_Host.cpp Minitel1B_Screen.cpp Minitel1B_Emulator.cpp mon_programme.cpp
+
+   Documentation utilisée :
+   Spécifications Techniques d'Utilisation du Minitel 1B
+   http://543210.free.fr/TV/stum1b.pdf
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#ifndef MINITEL1B_EMULATOR_H
+#define MINITEL1B_EMULATOR_H
+
+#if !defined(ARDUINO)  // Uniquement en dehors de l'environnement Arduino
+
+#include "Minitel1B_Screen.h"
+
+////////////////////////////////////////////////////////////////////////
+
+#define MINITEL_COLONNES_MIXTE  80  // Mode Mixte (voir p.144)
+
+class MinitelEmulator : public MinitelTransport
+{
+public:
+  MinitelEmulator();
+
+  // MinitelTransport : ce qui est écrit est affiché, ce qui est lu vient
+  // des réponses de l'émulateur et des touches simulées. Si la vitesse
+  // demandée par begin n'est pas celle de l'émulateur, les octets écrits
+  // sont perdus (comme avec un vrai Minitel).
+  virtual bool begin(long bauds);
+  virtual int available();
+  virtual int read();
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  virtual bool nativeParity(bool actif);
+
+  void reset();  // Etat à la mise sous tension (sans changer la vitesse)
+  void receive(byte b);  // Octet reçu de la ligne (le bit de parité est ignoré)
+  void receive(const byte* buffer, size_t size);
+  void pressKey(unsigned long code);  // Codes de getKeyCode(false) : 0x41, ENVOI, TOUCHE_FLECHE_HAUT...
+
+  // Ecran
+  int columns() const { return colonnes; }  // 40 (Vidéotex) ou 80 (Mixte)
+  MinitelCell getCell(int x, int y) const;  // Colonne x (à partir de 1) et rangée y (0 à 24). code = 0 : moitié d'un caractère double.
+  std::string row(int y) const;  // Rangée y en UTF-8 (semi-graphiques en caractères sextants, un seul caractère pour la double largeur)
+  std::string text() const;  // Rangées 0 à 24, une par ligne
+  int cursorX() const { return curseurX; }
+  int cursorY() const { return curseurY; }
+  bool cursorVisible() const { return curseurVisible; }
+  bool scrollMode() const { return rouleau; }
+  long speed() const { return vitesse; }
+  unsigned long bells() const { return bips; }
+  bool sameScreen(const MinitelEmulator& autre) const;  // Mêmes cases, même curseur, mêmes bips
+
+  // Réécrit une page Vidéotex avec le moins d'octets possible : l'écran
+  // obtenu est reconstruit, puis renvoyé par MinitelScreen (REP,
+  // déplacements du curseur et changements d'attributs au plus court).
+  // Le résultat est vérifié en l'interprétant à son tour. La page est
+  // renvoyée telle quelle si elle ne commence pas par FF, si elle laisse
+  // l'écran en mode Mixte ou rouleau, si elle ne peut être reproduite
+  // (caractère double en partie recouvert, par exemple) ou si rien n'est
+  // gagné.
+  static std::vector<byte> optimize(const byte* page, size_t size);
+
+private:
+  MinitelCell cases[MINITEL_RANGEES][MINITEL_COLONNES_MIXTE];
+  int colonnes;
+  int curseurX, curseurY;
+  bool curseurVisible;
+  bool rouleau;
+  bool insertion;
+  bool minuscules;
+  bool clavierEtendu;
+  byte liaisons[4];  // Emetteurs reliés à chaque récepteur (écran, clavier, modem, prise)
+  long vitesse;  // Vitesse du Minitel
+  long ligne;  // Vitesse demandée par begin
+  bool parite;
+  unsigned long bips;
+  std::deque<uint8_t> reponses;
+
+  // Attributs courants
+  MinitelCell stylo;  // Couleur, taille, clignotement, inversion et attributs de zone en attente de validation
+  byte fond, masquage, lignage;  // Attributs de zone validés
+  bool graphique;  // SO : jeu G1
+  byte dernier[3];  // Dernier caractère visualisé (code, diacritique, jeu) pour REP
+  // Position et attributs sauvegardés à l'entrée en rangée 0
+  int sauveX, sauveY;
+  MinitelCell sauveStylo;
+  bool sauveGraphique;
+
+  // Analyse du flux
+  byte etat;
+  byte intermediaire;  // ESC : octets de 0x20 à 0x2F ; CSI : '?'
+  byte nbParametres;
+  int parametres[2];
+  byte pro[3];
+  byte nbPro, attendusPro;
+  byte diacritique;
+  byte rangeeUS;
+
+  void clearCells(int y, int x1, int x2);
+  void clearRows(int y1, int y2);
+  void put(byte code, byte diacritic, byte set);
+  void moveTo(int x, int y);
+  void lineFeed();
+  void lineUp();
+  void scroll(int y1, int y2, int n);  // n > 0 : vers le haut
+  void separator();
+  void attribute(byte b);
+  void csi(byte final);
+  void protocol();
+  void reply(const byte* buffer, size_t size);
+  byte statusByte() const;
+};
+
+////////////////////////////////////////////////////////////////////////
+
+#endif  // Fin Si (!defined(ARDUINO))
+
+#endif  // Fin Si (MINITEL1B_EMULATOR_H)
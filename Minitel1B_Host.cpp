@@ -0,0 +1,487 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Minitel1B_Host - Fichier source - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+   https://entropie.org/3615/
+
+   Compilation native (Linux) de la bibliothèque Minitel1B_Soft.
+   Voir Minitel1B_Host.h
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#if !defined(ARDUINO)  // Uniquement en dehors de l'environnement Arduino
+
+#include "Minitel1B_Host.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <termios.h>
+
+////////////////////////////////////////////////////////////////////////
+/*
+   Temps
+*/
+////////////////////////////////////////////////////////////////////////
+
+static unsigned long long nowMicros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long) ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+/*--------------------------------------------------------------------*/
+
+static const unsigned long long ORIGINE = nowMicros();
+
+unsigned long millis() {
+  return (unsigned long) ((nowMicros() - ORIGINE) / 1000);
+}
+/*--------------------------------------------------------------------*/
+
+unsigned long micros() {
+  return (unsigned long) (nowMicros() - ORIGINE);
+}
+/*--------------------------------------------------------------------*/
+
+void delay(unsigned long ms) {
+  struct timespec ts;
+  ts.tv_sec = ms / 1000;
+  ts.tv_nsec = (ms % 1000) * 1000000L;
+  while (nanosleep(&ts, &ts) == -1 && errno == EINTR);
+}
+/*--------------------------------------------------------------------*/
+
+
+
+
+////////////////////////////////////////////////////////////////////////
+/*
+   String
+*/
+////////////////////////////////////////////////////////////////////////
+
+int String::indexOf(char caractere) const {
+  size_t index = s.find(caractere);
+  return (index == std::string::npos) ? -1 : (int) index;
+}
+/*--------------------------------------------------------------------*/
+
+int String::lastIndexOf(char caractere) const {
+  size_t index = s.rfind(caractere);
+  return (index == std::string::npos) ? -1 : (int) index;
+}
+/*--------------------------------------------------------------------*/
+
+void String::remove(unsigned int index) {
+  if (index < s.length()) s.erase(index);
+}
+/*--------------------------------------------------------------------*/
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index < s.length()) s.erase(index, count);
+}
+/*--------------------------------------------------------------------*/
+
+
+
+
+////////////////////////////////////////////////////////////////////////
+/*
+   MinitelFdTransport
+*/
+////////////////////////////////////////////////////////////////////////
+
+MinitelFdTransport::~MinitelFdTransport() {
+  if (descripteur >= 0) close(descripteur);
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelFdTransport::begin(long bauds) {
+  if (descripteur < 0 && !open()) return false;
+  return configure(bauds);
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelFdTransport::nativeParity(bool actif) {
+  bool ancienne = parite;
+  parite = actif;
+  marque = 0;
+  if (descripteur >= 0 && !configure(vitesse)) {
+    parite = ancienne;
+    configure(vitesse);
+    return false;
+  }
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelFdTransport::end() {
+  // Comme SoftwareSerial::end(), on cesse simplement d'écouter : le
+  // descripteur reste ouvert pour le begin() qui suit un changement de
+  // vitesse (un pseudo-terminal disparaîtrait à sa fermeture).
+  debut = fin = 0;
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelFdTransport::configure(long bauds) {
+  struct termios tio;
+  if (tcgetattr(descripteur, &tio) != 0) return false;
+  cfmakeraw(&tio);
+  tio.c_cflag &= ~(CSIZE | PARENB | PARODD | CSTOPB | CRTSCTS);
+  tio.c_cflag |= CLOCAL | CREAD;
+  if (parite) {
+    // 7 bits, parité paire, 1 stop : le pilote génère et vérifie la parité.
+    // Avec PARMRK, un octet erroné est reçu sous la forme 0xFF 0x00 x.
+    tio.c_cflag |= CS7 | PARENB;
+    tio.c_iflag |= INPCK | PARMRK;
+    tio.c_iflag &= ~(IGNPAR | ISTRIP);
+  }
+  else {
+    // La parité est calculée par la bibliothèque : 8 bits, sans parité, 1 stop.
+    tio.c_cflag |= CS8;
+  }
+  tio.c_cc[VMIN] = 0;
+  tio.c_cc[VTIME] = 0;
+  speed_t debit;
+  switch (bauds) {
+    case  300 : debit = B300;  break;
+    case 1200 : debit = B1200; break;
+    case 4800 : debit = B4800; break;
+    case 9600 : debit = B9600; break;
+    default   : return false;
+  }
+  vitesse = bauds;
+  cfsetispeed(&tio, debit);
+  cfsetospeed(&tio, debit);
+  // TCSADRAIN n'attend que le pilote : la file d'émission doit d'abord
+  // lui être entièrement confiée pour partir à l'ancienne vitesse.
+  while (!drain()) waitOutput();
+  return tcsetattr(descripteur, TCSADRAIN, &tio) == 0;  // Après la fin de l'émission en cours
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelFdTransport::fill() {
+  if (descripteur < 0) return false;
+  if (debut == fin) debut = fin = 0;
+  if (fin == sizeof(reception)) return true;  // Tampon plein
+  ssize_t n = ::read(descripteur, reception + fin, sizeof(reception) - fin);
+  if (n <= 0) return false;
+  if (!parite) {
+    fin += n;
+    return true;
+  }
+  // En 7E1, les données sont sur 7 bits : 0xFF ne peut être que le début
+  // d'une marque d'erreur 0xFF 0x00 x, que l'on retire du flux.
+  size_t lu = fin;
+  for (size_t i = fin; i < fin + (size_t) n; i++) {
+    uint8_t b = reception[i];
+    switch (marque) {
+      case 0 :
+        if (b == 0xFF) marque = 1;
+        else reception[lu++] = b;
+        break;
+      case 1 :
+        marque = (b == 0x00) ? 2 : 0;
+        if (b != 0x00) reception[lu++] = b;
+        break;
+      case 2 :
+        marque = 0;
+        erreursParite++;  // Octet x reçu avec une erreur de parité ou de trame : écarté
+        break;
+    }
+  }
+  fin = lu;
+  return fin > debut;
+}
+/*--------------------------------------------------------------------*/
+
+int MinitelFdTransport::available() {
+  fill();
+  return (int) (fin - debut);
+}
+/*--------------------------------------------------------------------*/
+
+int MinitelFdTransport::read() {
+  if (debut == fin && !fill()) return -1;
+  return reception[debut++];
+}
+/*--------------------------------------------------------------------*/
+
+size_t MinitelFdTransport::write(const uint8_t *buffer, size_t size) {
+  size_t total = 0;
+  if (capaciteFile > 0) {
+    if (queued() == 0) {  // Rien devant : directement au port, le reste en file
+      file.clear();
+      envoi = 0;
+      ssize_t n = ::write(descripteur, buffer, size);
+      if (n > 0) total = n;
+      else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) return 0;
+    }
+    while (descripteur >= 0 && total < size) {
+      if (queued() == capaciteFile) drain();  // Sans attendre le port
+      if (queued() == capaciteFile) {  // File pleine : le reste est refusé.
+        debordement = true;
+        break;
+      }
+      if (envoi > 0 && file.size() == capaciteFile) {  // Place libérée au début de la file
+        file.erase(file.begin(), file.begin() + envoi);
+        envoi = 0;
+      }
+      size_t n = capaciteFile - file.size();
+      if (n > size - total) n = size - total;
+      file.insert(file.end(), buffer + total, buffer + total + n);
+      total += n;
+    }
+    return total;
+  }
+  while (descripteur >= 0 && total < size) {
+    ssize_t n = ::write(descripteur, buffer + total, size - total);
+    if (n > 0) {
+      total += n;
+    }
+    else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      struct pollfd pfd = { descripteur, POLLOUT, 0 };
+      poll(&pfd, 1, 100);  // On attend que le port puisse accepter la suite
+    }
+    else if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    else {
+      break;  // Erreur : on abandonne
+    }
+  }
+  return total;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelFdTransport::flush() {
+  while (descripteur >= 0 && !drain()) waitOutput();
+  if (descripteur >= 0) tcdrain(descripteur);
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelFdTransport::setOutputQueue(size_t capacite) {
+  flush();
+  capaciteFile = capacite;
+  debordement = false;
+  file.clear();
+  file.shrink_to_fit();
+  file.reserve(capacite);  // Mémoire bornée, allouée une fois
+  envoi = 0;
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelFdTransport::drain() {
+  while (descripteur >= 0 && queued() > 0) {
+    ssize_t n = ::write(descripteur, file.data() + envoi, queued());
+    if (n > 0) {
+      envoi += n;
+    }
+    else if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return false;
+    }
+    else {
+      break;  // Erreur : le contenu de la file est abandonné.
+    }
+  }
+  file.clear();
+  envoi = 0;
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelFdTransport::waitOutput() {
+  struct pollfd pfd = { descripteur, POLLOUT, 0 };
+  poll(&pfd, 1, 100);
+}
+/*--------------------------------------------------------------------*/
+
+
+
+
+////////////////////////////////////////////////////////////////////////
+/*
+   MinitelTtyTransport
+*/
+////////////////////////////////////////////////////////////////////////
+
+MinitelTtyTransport::MinitelTtyTransport(const char *chemin) : chemin(chemin) {
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelTtyTransport::open() {
+  descripteur = ::open(chemin.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+  return descripteur >= 0;
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelTtyTransport::begin(long bauds) {
+  // Comme SoftwareSerial, on vide ce qui a été reçu à l'ancienne vitesse.
+  if (!MinitelFdTransport::begin(bauds)) return false;
+  tcflush(descripteur, TCIFLUSH);
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+
+
+
+////////////////////////////////////////////////////////////////////////
+/*
+   MinitelPtyTransport
+*/
+////////////////////////////////////////////////////////////////////////
+
+MinitelPtyTransport::MinitelPtyTransport() {
+  open();
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelPtyTransport::open() {
+  descripteur = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (descripteur < 0) return false;
+  if (grantpt(descripteur) != 0 || unlockpt(descripteur) != 0) {
+    close(descripteur);
+    descripteur = -1;
+    return false;
+  }
+  const char *nom = ptsname(descripteur);
+  nomEsclave = nom ? nom : "";
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelPtyTransport::begin(long bauds) {
+  // Le débit n'a pas de sens sur un pseudo-terminal : seul le mode brut compte.
+  if (descripteur < 0 && !open()) return false;
+  configure(bauds);
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+
+
+
+////////////////////////////////////////////////////////////////////////
+/*
+   MinitelFileTransport
+*/
+////////////////////////////////////////////////////////////////////////
+
+MinitelFileTransport::MinitelFileTransport(const char *sortie, const char *entree)
+  : cheminSortie(sortie ? sortie : ""), cheminEntree(entree ? entree : ""),
+    fichierSortie(NULL), fichierEntree(NULL) {
+}
+/*--------------------------------------------------------------------*/
+
+MinitelFileTransport::~MinitelFileTransport() {
+  if (fichierSortie != NULL) fclose((FILE *) fichierSortie);
+  if (fichierEntree != NULL) fclose((FILE *) fichierEntree);
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelFileTransport::begin(long bauds) {
+  (void) bauds;
+  if (fichierSortie == NULL && !cheminSortie.empty()) {
+    fichierSortie = fopen(cheminSortie.c_str(), "wb");
+    if (fichierSortie == NULL) return false;
+  }
+  if (fichierEntree == NULL && !cheminEntree.empty()) {
+    fichierEntree = fopen(cheminEntree.c_str(), "rb");
+    if (fichierEntree == NULL) return false;
+  }
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelFileTransport::end() {
+  // Un changement de vitesse (end() puis begin()) ne doit pas tronquer
+  // le fichier de sortie : on se contente de vider les tampons.
+  flush();
+}
+/*--------------------------------------------------------------------*/
+
+int MinitelFileTransport::available() {
+  FILE *f = (FILE *) fichierEntree;
+  if (f == NULL) return 0;
+  long position = ftell(f);
+  fseek(f, 0, SEEK_END);
+  long taille = ftell(f);
+  fseek(f, position, SEEK_SET);
+  return (int) (taille - position);
+}
+/*--------------------------------------------------------------------*/
+
+int MinitelFileTransport::read() {
+  FILE *f = (FILE *) fichierEntree;
+  if (f == NULL) return -1;
+  int c = fgetc(f);
+  return (c == EOF) ? -1 : c;
+}
+/*--------------------------------------------------------------------*/
+
+size_t MinitelFileTransport::write(const uint8_t *buffer, size_t size) {
+  FILE *f = (FILE *) fichierSortie;
+  if (f == NULL) return 0;
+  return fwrite(buffer, 1, size, f);
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelFileTransport::flush() {
+  if (fichierSortie != NULL) fflush((FILE *) fichierSortie);
+}
+/*--------------------------------------------------------------------*/
+
+
+
+
+////////////////////////////////////////////////////////////////////////
+/*
+   MinitelMemoryTransport
+*/
+////////////////////////////////////////////////////////////////////////
+
+int MinitelMemoryTransport::read() {
+  if (entree.empty()) return -1;
+  uint8_t b = entree.front();
+  entree.pop_front();
+  return b;
+}
+/*--------------------------------------------------------------------*/
+
+size_t MinitelMemoryTransport::write(const uint8_t *buffer, size_t size) {
+  sortie.insert(sortie.end(), buffer, buffer + size);
+  if (bouclage) feed(buffer, size);
+  return size;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelMemoryTransport::feed(const uint8_t *buffer, size_t size) {
+  entree.insert(entree.end(), buffer, buffer + size);
+}
+/*--------------------------------------------------------------------*/
+
+#endif  // Fin Si (!ARDUINO)
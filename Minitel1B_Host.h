@@ -0,0 +1,283 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Minitel1B_Host - Fichier d'en-tête - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+   https://entropie.org/3615/
+
+   Compilation native (Linux) de la bibliothèque Minitel1B_Soft.
+   Ce fichier remplace Arduino.h et SoftwareSerial.h lorsque la
+   constante ARDUINO n'est pas définie : il fournit les types et
+   fonctions Arduino utilisés par la bibliothèque (byte, word, String,
+   millis, delay, bitRead...) ainsi qu'une abstraction du port série
+   (MinitelTransport) et plusieurs implémentations :
+   - MinitelTtyTransport    : vrai port série (/dev/ttyS0, /dev/ttyUSB0...)
+   - MinitelPtyTransport    : pseudo-terminal (/dev/pts/N côté esclave)
+   - MinitelFileTransport   : émission vers un fichier, réception depuis un fichier
+   - MinitelMemoryTransport : tampons en mémoire (avec bouclage optionnel)
+   - MinitelEmulator        : écran de Minitel émulé (Minitel1B_Emulator.h)
+
+   Exemple de compilation :
+   g++ -O2 -I. Minitel1B_Soft.cpp Minitel1B_Host.cpp mon_programme.cpp
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#ifndef MINITEL1B_HOST_H
+#define MINITEL1B_HOST_H
+
+#if !defined(ARDUINO)  // Uniquement en dehors de l'environnement Arduino
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <deque>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+////////////////////////////////////////////////////////////////////////
+
+// Types et fonctions Arduino utilisés par la bibliothèque
+
+typedef uint8_t  byte;
+typedef uint16_t word;
+typedef bool     boolean;
+
+#define bitRead(value, bit)            (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)             ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)           ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define highByte(w)                    ((uint8_t) ((w) >> 8))
+#define lowByte(w)                     ((uint8_t) ((w) & 0xFF))
+
+// Pas de mémoire flash séparée sur un PC
+#define PROGMEM
+#define pgm_read_byte(addr)      (*(const uint8_t *)(addr))
+#define pgm_read_byte_near(addr) pgm_read_byte(addr)
+#define pgm_read_word(addr)      (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr)     (*(const uint32_t *)(addr))
+class __FlashStringHelper;  // Chaîne F("...") : en mémoire vive sur un PC
+#define F(chaine) (reinterpret_cast<const __FlashStringHelper *>(chaine))
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+// Sous-ensemble de la classe String d'Arduino
+class String
+{
+public:
+  String() {}
+  String(const char *chaine) : s(chaine ? chaine : "") {}
+  String(const std::string &chaine) : s(chaine) {}
+  String(char caractere) : s(1, caractere) {}
+
+  unsigned int length() const { return s.length(); }
+  char charAt(unsigned int index) const { return (index < s.length()) ? s[index] : 0; }
+  char operator[](unsigned int index) const { return charAt(index); }
+  const char *c_str() const { return s.c_str(); }
+  int indexOf(char caractere) const;
+  int lastIndexOf(char caractere) const;
+  void remove(unsigned int index);
+  void remove(unsigned int index, unsigned int count);
+  String &operator+=(const String &chaine) { s += chaine.s; return *this; }
+  String &operator+=(const char *chaine) { if (chaine) s += chaine; return *this; }
+  String &operator+=(char caractere) { s += caractere; return *this; }
+  bool operator==(const String &chaine) const { return s == chaine.s; }
+  bool operator!=(const String &chaine) const { return s != chaine.s; }
+
+private:
+  std::string s;
+};
+
+////////////////////////////////////////////////////////////////////////
+
+// Abstraction du port série
+
+class MinitelTransport
+{
+public:
+  virtual ~MinitelTransport() {}
+  virtual bool begin(long bauds) = 0;  // Ouverture ou changement de vitesse
+  virtual void end() {}
+  virtual int available() = 0;  // Nombre d'octets reçus en attente de lecture
+  virtual int read() = 0;  // -1 si aucun octet n'est disponible
+  virtual size_t write(const uint8_t *buffer, size_t size) = 0;
+  virtual void flush() {}  // Attend la fin de l'émission
+  // Parité gérée par le port (7 bits, parité paire, 1 stop) : renvoie false
+  // si le port ne sait pas le faire. Les octets reçus avec une erreur de
+  // parité sont alors écartés et comptés par parityErrors().
+  virtual bool nativeParity(bool actif) { return !actif; }
+  virtual unsigned long parityErrors() { return 0; }
+};
+/*--------------------------------------------------------------------*/
+
+// Tout ce qui se manipule avec un descripteur de fichier POSIX
+class MinitelFdTransport : public MinitelTransport
+{
+public:
+  virtual ~MinitelFdTransport();
+  virtual bool begin(long bauds);
+  virtual void end();
+  virtual int available();
+  virtual int read();
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  virtual void flush();
+  virtual bool nativeParity(bool actif);
+  virtual unsigned long parityErrors() { return erreursParite; }
+  int fd() const { return descripteur; }
+  // File d'émission (voir MinitelServer) : write() rend la main aussitôt,
+  // ce que le port n'accepte pas encore attend dans la file et part avec
+  // drain(). Ce qui ne tient plus dans la file est refusé : write() renvoie
+  // alors moins que size, sans attendre le port.
+  // begin() et nativeParity() attendent que la file soit vide.
+  void setOutputQueue(size_t capacite);  // 0 par défaut : write() attend que tout soit parti
+  size_t queued() const { return file.size() - envoi; }  // Octets en attente dans la file
+  size_t queueCapacity() const { return capaciteFile; }
+  bool overflowed() const { return debordement; }  // Octets refusés depuis setOutputQueue
+  bool drain();  // Envoie ce que le port accepte sans attendre. true si la file est vide.
+
+protected:
+  MinitelFdTransport() : descripteur(-1), vitesse(1200), parite(false), marque(0), erreursParite(0), debut(0), fin(0), capaciteFile(0), envoi(0), debordement(false) {}
+  virtual bool open() = 0;
+  bool configure(long bauds);  // termios : mode brut, 8N1 ou 7E1
+  bool fill();  // Lecture non bloquante dans le tampon de réception
+  int descripteur;
+  long vitesse;
+  bool parite;  // true : 7E1 géré par le pilote
+
+private:
+  byte marque;  // Position dans une séquence d'erreur 0xFF 0x00 x (PARMRK)
+  unsigned long erreursParite;
+  uint8_t reception[256];
+  size_t debut, fin;
+  size_t capaciteFile;
+  std::vector<uint8_t> file;  // Octets en attente à partir de file[envoi]
+  size_t envoi;
+  bool debordement;
+  void waitOutput();
+};
+/*--------------------------------------------------------------------*/
+
+class MinitelTtyTransport : public MinitelFdTransport
+{
+public:
+  MinitelTtyTransport(const char *chemin);  // /dev/ttyUSB0 par exemple
+  virtual bool begin(long bauds);
+
+protected:
+  virtual bool open();
+
+private:
+  std::string chemin;
+};
+/*--------------------------------------------------------------------*/
+
+class MinitelPtyTransport : public MinitelFdTransport
+{
+public:
+  MinitelPtyTransport();  // Le pseudo-terminal est créé immédiatement
+  const char *slaveName() const { return nomEsclave.c_str(); }  // A ouvrir par l'autre extrémité
+  virtual bool begin(long bauds);
+
+protected:
+  virtual bool open();
+
+private:
+  std::string nomEsclave;
+};
+/*--------------------------------------------------------------------*/
+
+class MinitelFileTransport : public MinitelTransport
+{
+public:
+  // Les octets émis sont écrits dans sortie, les octets reçus sont lus
+  // dans entree (facultatif).
+  MinitelFileTransport(const char *sortie, const char *entree = NULL);
+  virtual ~MinitelFileTransport();
+  virtual bool begin(long bauds);
+  virtual void end();
+  virtual int available();
+  virtual int read();
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  virtual void flush();
+
+private:
+  std::string cheminSortie, cheminEntree;
+  void *fichierSortie;  // FILE*
+  void *fichierEntree;  // FILE*
+};
+/*--------------------------------------------------------------------*/
+
+class MinitelMemoryTransport : public MinitelTransport
+{
+public:
+  // En mode bouclage, tout octet émis est aussi reçu (comme un Minitel
+  // qui renverrait tout ce qu'on lui envoie).
+  MinitelMemoryTransport(bool bouclage = false) : bouclage(bouclage), vitesse(0), parite(false) {}
+  virtual bool begin(long bauds) { vitesse = bauds; return true; }
+  virtual int available() { return (int) entree.size(); }
+  virtual int read();
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  virtual bool nativeParity(bool actif) { parite = actif; return true; }  // Simulée : les octets passent tels quels
+
+  void feed(const uint8_t *buffer, size_t size);  // Simule la réception d'octets
+  void feed(uint8_t b) { feed(&b, 1); }
+  const std::vector<uint8_t> &output() const { return sortie; }  // Octets émis
+  void clearOutput() { sortie.clear(); }
+  long speed() const { return vitesse; }
+  bool parity() const { return parite; }
+
+private:
+  bool bouclage;
+  long vitesse;
+  bool parite;
+  std::deque<uint8_t> entree;
+  std::vector<uint8_t> sortie;
+};
+
+////////////////////////////////////////////////////////////////////////
+
+// Remplace SoftwareSerial : mêmes fonctions, appliquées à un transport.
+class MinitelSerial
+{
+public:
+  MinitelSerial(MinitelTransport &transport) : port(&transport) {}
+
+  void begin(long bauds) { port->begin(bauds); }
+  void end() { port->end(); }
+  bool listen() { return true; }
+  bool isListening() { return true; }  // Pas de limite à un port à l'écoute
+  int available() { return port->available(); }
+  int read() { return port->read(); }
+  size_t write(uint8_t b) { return port->write(&b, 1); }
+  size_t write(const uint8_t *buffer, size_t size) { return port->write(buffer, size); }
+  void flush() { port->flush(); }
+  bool nativeParity(bool actif) { return port->nativeParity(actif); }
+  unsigned long parityErrors() { return port->parityErrors(); }
+  MinitelTransport &transport() { return *port; }
+
+private:
+  MinitelTransport *port;
+};
+
+////////////////////////////////////////////////////////////////////////
+
+#endif  // Fin Si (!ARDUINO)
+
+#endif  // Fin Si (MINITEL1B_HOST_H)
@@ -0,0 +1,281 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Minitel1B_Image - Fichier source - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+   https://entropie.org/3615/
+
+   Documentation utilisée :
+   Spécifications Techniques d'Utilisation du Minitel 1B
+   http://543210.free.fr/TV/stum1b.pdf
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#if !defined(ARDUINO)  // Uniquement en dehors de l'environnement Arduino
+
+#include "Minitel1B_Image.h"
+#include <thread>
+#include <memory>
+
+// Couleurs classées de la plus sombre à la plus claire, telles que les
+// rend l'écran noir et blanc du Minitel 1B (0 = CARACTERE_NOIR).
+static const byte NIVEAUX[8] = { 0, 4, 1, 5, 2, 6, 3, 7 };  // Noir, bleu, rouge, magenta, vert, cyan, jaune, blanc
+#define LUMINANCE(n)  ((n) * 255 / 7)  // Niveau de gris n => 0 à 255
+
+static inline int borne(int v) {
+  return (v < 0) ? 0 : (v > 255) ? 255 : v;
+}
+
+////////////////////////////////////////////////////////////////////////
+/*
+   Public
+*/
+////////////////////////////////////////////////////////////////////////
+
+MinitelImage::MinitelImage() : zoneX(1), zoneY(1), colonnes(MINITEL_COLONNES), rangees(MINITEL_RANGEES-1), fils(0), diffusion(true) {}
+/*--------------------------------------------------------------------*/
+
+void MinitelImage::setArea(int x, int y, int columns, int rows) {
+  zoneX = x;
+  zoneY = y;
+  colonnes = columns;
+  rangees = rows;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelImage::setThreads(int n) {
+  fils = n;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelImage::setDithering(bool actif) {
+  diffusion = actif;
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelImage::convert(const byte* pixels, int width, int height, int channels, MinitelScreen& ecran, size_t stride) {
+  if (pixels == NULL || width < 1 || height < 1) return false;
+  if (channels != 1 && channels != 3 && channels != 4) return false;
+  if (stride == 0) stride = (size_t) width * channels;
+  if (stride < (size_t) width * channels) return false;
+  if (colonnes < 1 || rangees < 1 || zoneX < 1 || zoneY < 0) return false;
+  if (zoneX + colonnes - 1 > MINITEL_COLONNES || zoneY + rangees - 1 >= MINITEL_RANGEES) return false;
+
+  const int hauteur = 3 * rangees;  // En pavés
+  paves.assign((size_t) 2 * colonnes * hauteur, 0);
+  cases.resize((size_t) colonnes * rangees);
+  int n = fils;
+  if (n <= 0) n = std::thread::hardware_concurrency();
+  if (n < 1) n = 1;
+
+  // Mise à l'échelle : chaque fil traite une bande de lignes de pavés.
+  int bandes = (n < hauteur) ? n : hauteur;
+  if (bandes == 1) {
+    scale(pixels, width, height, channels, stride, 0, hauteur);
+  }
+  else {
+    std::vector<std::thread> travail;
+    for (int k=0; k<bandes; k++) {
+      travail.push_back(std::thread(&MinitelImage::scale, this, pixels, width, height, channels, stride,
+                                    k * hauteur / bandes, (k+1) * hauteur / bandes));
+    }
+    for (size_t k=0; k<travail.size(); k++) travail[k].join();
+  }
+
+  // Choix des cases : la rangée r est confiée au fil r % n et attend que
+  // la rangée précédente ait fini de lui diffuser son erreur.
+  std::unique_ptr<std::atomic<int>[]> avancement(new std::atomic<int>[rangees]);
+  for (int r=0; r<rangees; r++) avancement[r].store(0);
+  int equipes = (n < rangees) ? n : rangees;
+  if (equipes == 1) {
+    for (int r=0; r<rangees; r++) quantize(r, avancement.get());
+  }
+  else {
+    std::vector<std::thread> travail;
+    for (int k=0; k<equipes; k++) {
+      travail.push_back(std::thread([this, k, equipes, &avancement]() {
+        for (int r=k; r<rangees; r+=equipes) quantize(r, avancement.get());
+      }));
+    }
+    for (size_t k=0; k<travail.size(); k++) travail[k].join();
+  }
+
+  for (int r=0; r<rangees; r++) {
+    for (int c=0; c<colonnes; c++) {
+      ecran.setCell(zoneX + c, zoneY + r, cases[(size_t) r * colonnes + c]);
+    }
+  }
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+
+////////////////////////////////////////////////////////////////////////
+/*
+   Privé
+*/
+////////////////////////////////////////////////////////////////////////
+
+void MinitelImage::scale(const byte* pixels, int width, int height, int channels, size_t stride, int j1, int j2) {
+  // Chaque pavé reçoit la moyenne des pixels qu'il recouvre (au moins un).
+  // Les lignes de pixels sont d'abord cumulées colonne par colonne : ces
+  // boucles sans branchement sont vectorisées par le compilateur.
+  const int largeur = 2 * colonnes;
+  const int hauteur = 3 * rangees;
+  std::vector<uint32_t> cumul(width);
+  uint32_t* somme = cumul.data();
+  for (int j=j1; j<j2; j++) {
+    int y1 = (int) ((long long) j * height / hauteur);
+    int y2 = (int) ((long long) (j+1) * height / hauteur);
+    if (y2 <= y1) y2 = y1 + 1;
+    for (int k=0; k<width; k++) somme[k] = 0;
+    for (int y=y1; y<y2; y++) {
+      const byte* p = pixels + (size_t) y * stride;
+      switch (channels) {
+        case 1 :
+          for (int k=0; k<width; k++) somme[k] += p[k];
+          break;
+        case 3 :  // Luminance (ITU-R BT.601) en virgule fixe
+          for (int k=0; k<width; k++) somme[k] += (77 * p[3*k] + 150 * p[3*k+1] + 29 * p[3*k+2]) >> 8;
+          break;
+        case 4 :
+          for (int k=0; k<width; k++) somme[k] += (77 * p[4*k] + 150 * p[4*k+1] + 29 * p[4*k+2]) >> 8;
+          break;
+      }
+    }
+    int* ligne = paves.data() + (size_t) j * largeur;
+    for (int i=0; i<largeur; i++) {
+      int x1 = (int) ((long long) i * width / largeur);
+      int x2 = (int) ((long long) (i+1) * width / largeur);
+      if (x2 <= x1) x2 = x1 + 1;
+      uint32_t total = 0;
+      for (int x=x1; x<x2; x++) total += somme[x];
+      ligne[i] = (int) (total / ((uint32_t) (x2 - x1) * (y2 - y1)));
+    }
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelImage::quantize(int rangee, std::atomic<int>* avancement) {
+  const int largeur = 2 * colonnes;
+  const int hauteur = 3 * rangees;
+  // Couleurs de la case précédente : une case d'une seule couleur garde
+  // l'autre inchangée, ce qui évite des changements d'attributs.
+  byte couleurAvant = CARACTERE_BLANC - CARACTERE_NOIR;
+  byte fondAvant = 0;
+  for (int c=0; c<colonnes; c++) {
+    if (rangee > 0) {
+      // La case (rangee-1, c+1) diffuse encore son erreur sur cette case.
+      int attendu = (c + 2 < colonnes) ? c + 2 : colonnes;
+      while (avancement[rangee-1].load(std::memory_order_acquire) < attendu) std::this_thread::yield();
+    }
+    // Pavés de la case, de gauche à droite et de haut en bas
+    int* pave[6];
+    for (int i=0; i<6; i++) pave[i] = paves.data() + (size_t) (3*rangee + i/2) * largeur + 2*c + i%2;
+
+    // Couple de niveaux (a sombre, b clair) le plus proche des 6 pavés
+    int ecart[8][6];
+    for (int n=0; n<8; n++) {
+      for (int i=0; i<6; i++) {
+        int d = borne(*pave[i]) - LUMINANCE(n);
+        ecart[n][i] = d * d;
+      }
+    }
+    int a = 0, b = 0;
+    int meilleur = -1;
+    for (int na=0; na<8; na++) {
+      for (int nb=na; nb<8; nb++) {
+        int total = 0;
+        for (int i=0; i<6; i++) total += (ecart[na][i] < ecart[nb][i]) ? ecart[na][i] : ecart[nb][i];
+        if (meilleur < 0 || total < meilleur) {
+          meilleur = total;
+          a = na;
+          b = nb;
+        }
+      }
+    }
+
+    // Chaque pavé prend le niveau le plus proche, l'erreur est diffusée
+    // (Floyd-Steinberg). Ce qui tomberait sur un pavé déjà traité (case
+    // précédente) ou hors de l'image est reporté sur le pavé du dessous.
+    byte motif = 0;
+    for (int i=0; i<6; i++) {
+      int valeur = borne(*pave[i]);
+      bool clair = (valeur - LUMINANCE(a) > LUMINANCE(b) - valeur);
+      if (clair) motif |= 0b100000 >> i;
+      if (!diffusion) continue;
+      int erreur = valeur - LUMINANCE(clair ? b : a);
+      int px = 2*c + i%2;
+      int py = 3*rangee + i/2;
+      bool droite = (px + 1 < largeur);
+      bool dessous = (py + 1 < hauteur);
+      bool gauche = (px > 0) && dessous && !(i%2 == 0 && i/2 < 2);
+      int poidsDroite = droite ? 7 : 0;
+      int poidsGauche = gauche ? 3 : 0;
+      int poidsDessous = dessous ? 5 : 0;
+      int poidsDiagonale = (droite && dessous) ? 1 : 0;
+      int reste = 16 - poidsDroite - poidsGauche - poidsDessous - poidsDiagonale;
+      if (dessous) poidsDessous += reste;
+      else if (droite) poidsDroite += reste;
+      int* p = pave[i];
+      if (poidsDroite) p[1] += erreur * poidsDroite / 16;
+      if (poidsGauche) p[largeur-1] += erreur * poidsGauche / 16;
+      if (poidsDessous) p[largeur] += erreur * poidsDessous / 16;
+      if (poidsDiagonale) p[largeur+1] += erreur * poidsDiagonale / 16;
+    }
+
+    // Couleur de caractère pour les pavés allumés, de fond pour les autres
+    byte couleur, fond;
+    if (a == b || motif == 0) {
+      motif = 0;
+      couleur = couleurAvant;
+      fond = NIVEAUX[a];
+    }
+    else if (motif == 0b111111) {
+      couleur = NIVEAUX[b];
+      fond = fondAvant;
+    }
+    else {
+      couleur = NIVEAUX[b];
+      fond = NIVEAUX[a];
+      // Inverser le motif si cela reprend les couleurs de la case précédente
+      if ((NIVEAUX[a] == couleurAvant) + (NIVEAUX[b] == fondAvant) > (couleur == couleurAvant) + (fond == fondAvant)) {
+        couleur = NIVEAUX[a];
+        fond = NIVEAUX[b];
+        motif ^= 0b111111;
+      }
+    }
+    couleurAvant = couleur;
+    fondAvant = fond;
+
+    MinitelCell& cell = cases[(size_t) rangee * colonnes + c];
+    cell.code = Minitel::getGraphicByte(motif);
+    cell.diacritic = 0;
+    cell.set = JEU_G1;
+    cell.color = couleur;
+    cell.background = fond;
+    cell.size = 0;
+    cell.blink = 0;
+    cell.mask = 0;
+    cell.underline = 0;
+    cell.inverse = 0;
+    avancement[rangee].store(c + 1, std::memory_order_release);
+  }
+}
+/*--------------------------------------------------------------------*/
+
+#endif  // Fin Si (!defined(ARDUINO))
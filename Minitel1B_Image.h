@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Minitel1B_Image - Fichier d'en-tête - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+   https://entropie.org/3615/
+
+   Conversion d'une image (niveaux de gris ou couleurs) en caractères
+   semi-graphiques du jeu G1 (Linux seulement).
+
+   L'image est ramenée à la grille des pavés semi-graphiques (2 x 3 pavés
+   par case, soit 80 x 72 pavés pour les rangées 1 à 24), puis chaque case
+   reçoit le couple couleur de caractère / couleur de fond qui rend le
+   mieux ses 6 pavés parmi les 8 niveaux de gris du Minitel 1B. L'erreur
+   commise est diffusée aux pavés voisins (Floyd-Steinberg).
+
+   Les cases sont écrites dans un MinitelScreen : commit() envoie alors
+   le flux Vidéotex le plus court et, d'une image à la suivante (vidéo,
+   caméra), seulement les cases qui ont changé.
+
+   La mise à l'échelle est répartie entre plusieurs fils d'exécution par
+   bandes de rangées, la diffusion d'erreur en front d'onde (une rangée de
+   cases suit la précédente à deux cases d'écart). Les boucles sur les
+   pixels sont écrites pour être vectorisées par le compilateur (-O3).
+
+   Exemple de compilation :
+   g++ -O3 -pthread -I. Minitel1B_Soft.cpp Minitel1B_Host.cpp Minitel1B_Screen.cpp Minitel1B_Image.cpp mon_programme.cpp
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#ifndef MINITEL1B_IMAGE_H
+#define MINITEL1B_IMAGE_H
+
+#if !defined(ARDUINO)  // Uniquement en dehors de l'environnement Arduino
+
+#include "Minitel1B_Screen.h"
+#include <atomic>
+
+////////////////////////////////////////////////////////////////////////
+
+class MinitelImage
+{
+public:
+  MinitelImage();
+
+  void setArea(int x, int y, int columns, int rows);  // Cases occupées par l'image (par défaut : 1, 1, 40, 24)
+  void setThreads(int n);  // Nombre de fils d'exécution (0, par défaut : un par processeur)
+  void setDithering(bool actif);  // Diffusion d'erreur (par défaut : oui)
+
+  // Convertit une image rangée ligne par ligne, de haut en bas, avec 1
+  // (niveaux de gris), 3 (RVB) ou 4 (RVBA) octets par pixel. stride est
+  // le nombre d'octets d'une ligne (0 : width * channels). L'image est
+  // étirée sur toute la zone choisie par setArea. Renvoie false si les
+  // paramètres ne conviennent pas (l'écran n'est alors pas modifié).
+  bool convert(const byte* pixels, int width, int height, int channels, MinitelScreen& ecran, size_t stride = 0);
+
+private:
+  int zoneX, zoneY, colonnes, rangees;
+  int fils;
+  bool diffusion;
+  std::vector<int> paves;  // Luminance de chaque pavé (0 à 255), erreur diffusée comprise
+  std::vector<MinitelCell> cases;
+
+  void scale(const byte* pixels, int width, int height, int channels, size_t stride, int j1, int j2);
+  void quantize(int rangee, std::atomic<int>* avancement);  // avancement[r] : cases terminées de la rangée r
+};
+
+////////////////////////////////////////////////////////////////////////
+
+#endif  // Fin Si (!defined(ARDUINO))
+
+#endif  // Fin Si (MINITEL1B_IMAGE_H)
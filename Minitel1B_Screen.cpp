@@ -0,0 +1,357 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Minitel1B_Screen - Fichier source - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+   https://entropie.org/3615/
+
+   Documentation utilisée :
+   Spécifications Techniques d'Utilisation du Minitel 1B
+   http://543210.free.fr/TV/stum1b.pdf
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#include "Minitel1B_Screen.h"
+
+// Nombre maximum de cases inchangées renvoyées pour réunir deux zones
+// modifiées d'une même rangée, plutôt que de repositionner le curseur
+// (US + rangée + colonne = 3 octets, plus les attributs à rétablir).
+#define ECART_MAX  4
+
+////////////////////////////////////////////////////////////////////////
+/*
+   Public
+*/
+////////////////////////////////////////////////////////////////////////
+
+MinitelScreen::MinitelScreen(Minitel& minitel) : minitel(&minitel) {
+  clear();
+  invalidate();
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelScreen::clear() {
+  pen = blank();
+  for (int y=0; y<MINITEL_RANGEES; y++) {
+    for (int x=0; x<MINITEL_COLONNES; x++) {
+      next[y][x] = pen;
+    }
+  }
+  cursorX = 1;
+  cursorY = 1;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelScreen::moveCursorXY(int x, int y) {
+  cursorX = x;
+  cursorY = y;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelScreen::attributs(byte attribut) {
+  if (attribut >= CARACTERE_NOIR && attribut <= CARACTERE_BLANC) {
+    pen.color = attribut - CARACTERE_NOIR;
+  }
+  else if (attribut >= FOND_NOIR && attribut <= FOND_BLANC) {
+    pen.background = attribut - FOND_NOIR;
+  }
+  else if (attribut >= GRANDEUR_NORMALE && attribut <= DOUBLE_GRANDEUR) {
+    pen.size = attribut - GRANDEUR_NORMALE;
+  }
+  else {
+    switch (attribut) {
+      case CLIGNOTEMENT   : pen.blink = 1; break;
+      case FIXE           : pen.blink = 0; break;
+      case MASQUAGE       : pen.mask = 1; break;
+      case DEMASQUAGE     : pen.mask = 0; break;
+      case DEBUT_LIGNAGE  : pen.underline = 1; break;
+      case FIN_LIGNAGE    : pen.underline = 0; break;
+      case INVERSION_FOND : pen.inverse = 1; break;
+      case FOND_NORMAL    : pen.inverse = 0; break;
+    }
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelScreen::print(String chaine) {
+  unsigned int i = 0;
+  while (i < chaine.length()) {
+    unsigned long code = minitel->getVideotexCode(chaine, i);
+    if (code == 0) continue;
+    if (code <= 0xFF) {                     // Jeu G0
+      put((byte) code, 0, JEU_G0);
+    }
+    else if ((code >> 16) == SS2) {         // Jeu G2 : diacritique + lettre
+      put((byte) code, (byte) (code >> 8), JEU_G2);
+    }
+    else if ((code >> 8) == SS2) {          // Jeu G2
+      put((byte) code, 0, JEU_G2);
+    }
+    else if ((code >> 8) == SI) {           // Majuscule accentuée => Jeu G0
+      put((byte) code, 0, JEU_G0);
+    }
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelScreen::printChar(char caractere) {
+  byte charByte = minitel->getCharByte(caractere);
+  if (charByte >= SP && charByte <= DEL) {
+    put(charByte, 0, JEU_G0);
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelScreen::printSpecialChar(byte b) {
+  put(b, 0, JEU_G2);
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelScreen::graphic(byte b, int x, int y) {
+  moveCursorXY(x,y);
+  graphic(b);
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelScreen::graphic(byte b) {
+  if (b <= 0b111111) {
+    put(minitel->getGraphicByte(b), 0, JEU_G1);
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelScreen::setCell(int x, int y, MinitelCell cell) {
+  if (x >= 1 && x <= MINITEL_COLONNES && y >= 0 && y < MINITEL_RANGEES) {
+    next[y][x-1] = cell;
+  }
+}
+/*--------------------------------------------------------------------*/
+
+MinitelCell MinitelScreen::getCell(int x, int y) {
+  if (x >= 1 && x <= MINITEL_COLONNES && y >= 0 && y < MINITEL_RANGEES) {
+    return next[y][x-1];
+  }
+  return blank();
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelScreen::commit() {
+  minitel->holdFlush();  // Tout part d'un bloc
+  if (unknown) {
+    // Effacement complet : l'écran affiché devient un écran vide.
+    // FF n'efface pas la rangée 0, que l'on suppose vide elle aussi.
+    minitel->newScreen();
+    MinitelCell vide = blank();
+    for (int y=0; y<MINITEL_RANGEES; y++) {
+      for (int x=0; x<MINITEL_COLONNES; x++) {
+        shown[y][x] = vide;
+      }
+    }
+    unknown = false;
+  }
+  for (int y=0; y<MINITEL_RANGEES; y++) {
+    int x = 0;
+    while (x < MINITEL_COLONNES) {
+      if (next[y][x] == shown[y][x]) {
+        x++;
+        continue;
+      }
+      // Zone modifiée : on la prolonge tant que les cases inchangées
+      // qui séparent deux modifications sont peu nombreuses.
+      int debut = x;
+      int fin = x;
+      int ecart = 0;
+      for (int k=x+1; k<MINITEL_COLONNES; k++) {
+        if (next[y][k] != shown[y][k]) {
+          fin = k;
+          ecart = 0;
+        }
+        else if (++ecart > ECART_MAX) {
+          break;
+        }
+      }
+      renderRun(debut, fin, y);
+      for (int k=debut; k<=fin; k++) {
+        shown[y][k] = next[y][k];
+      }
+      x = fin + 1;
+    }
+  }
+  minitel->releaseFlush();
+  minitel->flush();
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelScreen::invalidate() {
+  unknown = true;
+}
+/*--------------------------------------------------------------------*/
+
+
+
+
+////////////////////////////////////////////////////////////////////////
+/*
+   Private
+*/
+////////////////////////////////////////////////////////////////////////
+
+MinitelCell MinitelScreen::blank() {
+  // Case vide après FF ou en début de rangée : espace blanc sur fond noir
+  MinitelCell c;
+  c.code = SP;
+  c.diacritic = 0;
+  c.set = JEU_G0;
+  c.color = CARACTERE_BLANC - CARACTERE_NOIR;
+  c.background = 0;
+  c.size = 0;
+  c.blink = 0;
+  c.mask = 0;
+  c.underline = 0;
+  c.inverse = 0;
+  return c;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelScreen::put(byte code, byte diacritic, byte set) {
+  MinitelCell c = pen;
+  c.code = code;
+  c.diacritic = diacritic;
+  c.set = set;
+  setCell(cursorX, cursorY, c);
+  // Le curseur avance d'une case, ou de deux en double largeur.
+  cursorX += (set != JEU_G1 && (c.size & 0b10)) ? 2 : 1;
+  if (cursorX > MINITEL_COLONNES) {
+    cursorX = 1;
+    cursorY = (cursorY >= MINITEL_RANGEES-1) ? 1 : cursorY+1;
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelScreen::renderRun(int x1, int x2, int y) {
+  // Les cases x1 à x2 (comptées à partir de 0) de la rangée y sont
+  // réécrites. Le positionnement par US remet les attributs à leur valeur
+  // par défaut (voir p.96) : on part donc d'un état connu.
+  minitel->newXY(x1+1, y);
+  MinitelCell etat = blank();  // Attributs courants du Minitel
+  MinitelCell zone = etat;     // Attributs de zone validés (fond, masquage, lignage)
+  boolean refaire = false;     // Colonne 39 recouverte par un délimiteur
+  for (int x=x1; x<=x2; x++) {
+    const MinitelCell& c = next[y][x];
+    boolean graphique = (c.set == JEU_G1);
+    // Jeu G0 ou G1
+    if (graphique && etat.set != JEU_G1) {
+      minitel->graphicMode();
+      etat.set = JEU_G1;
+    }
+    else if (!graphique && etat.set == JEU_G1) {
+      minitel->textMode();
+      etat.set = JEU_G0;
+    }
+    // Attributs de zone (voir p.93) : en mode texte, ils ne prennent effet
+    // qu'au délimiteur suivant (un espace). Si la case n'est pas elle-même
+    // un espace, on écrit un espace délimiteur puis on revient dessus.
+    // Un caractère semi-graphique est lui-même un délimiteur.
+    if (c.background != etat.background) {
+      minitel->writeByte(ESC);
+      minitel->writeByte(FOND_NOIR + c.background);
+      etat.background = c.background;
+    }
+    if (c.mask != etat.mask) {
+      minitel->writeByte(ESC);
+      minitel->writeByte(c.mask ? MASQUAGE : DEMASQUAGE);
+      etat.mask = c.mask;
+    }
+    if (c.underline != etat.underline) {
+      minitel->writeByte(ESC);
+      minitel->writeByte(c.underline ? DEBUT_LIGNAGE : FIN_LIGNAGE);
+      etat.underline = c.underline;
+    }
+    boolean delimiteur = graphique || (c.set == JEU_G0 && c.code == SP);
+    if (!delimiteur
+        && (zone.background != etat.background || zone.mask != etat.mask || zone.underline != etat.underline)) {
+      if (etat.size != 0) {  // L'espace délimiteur doit occuper une seule case
+        minitel->writeByte(ESC);
+        minitel->writeByte(GRANDEUR_NORMALE);
+        etat.size = 0;
+      }
+      if (x < MINITEL_COLONNES-1) {
+        minitel->writeByte(SP);
+        minitel->writeByte(BS);
+      }
+      else {
+        // En colonne 40, l'espace ferait passer à la rangée suivante (et
+        // BS revenir avec les attributs par défaut) : le délimiteur est
+        // écrit en colonne 39, redessinée ensuite.
+        minitel->writeByte(BS);
+        minitel->writeByte(SP);
+        refaire = true;
+      }
+      delimiteur = true;
+    }
+    if (delimiteur) {
+      zone.background = etat.background;
+      zone.mask = etat.mask;
+      zone.underline = etat.underline;
+    }
+    // Attributs de caractère
+    if (c.color != etat.color) {
+      minitel->writeByte(ESC);
+      minitel->writeByte(CARACTERE_NOIR + c.color);
+      etat.color = c.color;
+    }
+    if (c.blink != etat.blink) {
+      minitel->writeByte(ESC);
+      minitel->writeByte(c.blink ? CLIGNOTEMENT : FIXE);
+      etat.blink = c.blink;
+    }
+    if (!graphique) {  // Non utilisables en mode graphique
+      if (c.size != etat.size) {
+        // Pas de Minitel::attributs ici : il descendrait le curseur.
+        minitel->writeByte(ESC);
+        minitel->writeByte(GRANDEUR_NORMALE + c.size);
+        etat.size = c.size;
+      }
+      if (c.inverse != etat.inverse) {
+        minitel->writeByte(ESC);
+        minitel->writeByte(c.inverse ? INVERSION_FOND : FOND_NORMAL);
+        etat.inverse = c.inverse;
+      }
+    }
+    // Caractère
+    if (c.set == JEU_G2) {
+      minitel->writeByte(SS2);
+      if (c.diacritic != 0) minitel->writeByte(c.diacritic);
+    }
+    minitel->writeByte(c.code);
+    if (!graphique && (c.size & 0b10)) x++;  // Double largeur : la case suivante est recouverte
+  }
+  if (refaire) {
+    // La colonne 39 est redessinée, depuis la colonne 38 si elle est la
+    // moitié droite d'un caractère en double largeur.
+    int debut = MINITEL_COLONNES-2;
+    for (int x=0; x<MINITEL_COLONNES-2; x++) {
+      const MinitelCell& c = next[y][x];
+      if (c.set != JEU_G1 && (c.size & 0b10)) {
+        if (x == MINITEL_COLONNES-3) debut = x;
+        x++;
+      }
+    }
+    renderRun(debut, MINITEL_COLONNES-2, y);
+  }
+}
+/*--------------------------------------------------------------------*/
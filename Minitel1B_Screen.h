@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Minitel1B_Screen - Fichier d'en-tête - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+   https://entropie.org/3615/
+
+   Ecran virtuel : l'application dessine dans une copie en mémoire de
+   l'écran Vidéotex (40 colonnes, rangées 0 à 24), puis commit() envoie
+   au Minitel uniquement ce qui a changé depuis le commit() précédent.
+
+   Attention ! Deux écrans de 25 x 40 cases occupent 8 Ko de mémoire vive :
+   c'est trop pour un ATMega 328P (2 Ko), pas pour un ESP32 ou un PC.
+
+   Documentation utilisée :
+   Spécifications Techniques d'Utilisation du Minitel 1B
+   http://543210.free.fr/TV/stum1b.pdf
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#ifndef MINITEL1B_SCREEN_H
+#define MINITEL1B_SCREEN_H
+
+#include "Minitel1B_Soft.h"
+
+////////////////////////////////////////////////////////////////////////
+
+// Dimensions de l'écran Vidéotex (la rangée 0 est la ligne de service)
+#define MINITEL_COLONNES  40
+#define MINITEL_RANGEES   25
+
+// Jeux de caractères d'une case
+#define JEU_G0  0  // Alphanumérique
+#define JEU_G1  1  // Semi-graphique
+#define JEU_G2  2  // Complément à G0 (précédé de SS2)
+
+// Contenu d'une case de l'écran
+struct MinitelCell
+{
+  byte code;            // Code du caractère dans son jeu
+  byte diacritic;       // Jeu G2 uniquement : ACCENT_GRAVE, ACCENT_AIGU, ACCENT_CIRCONFLEXE, TREMA, CEDILLE ou 0
+  byte set : 2;         // JEU_G0, JEU_G1 ou JEU_G2
+  byte color : 3;       // Couleur de caractère : 0 (CARACTERE_NOIR) à 7 (CARACTERE_BLANC)
+  byte background : 3;  // Couleur de fond : 0 (FOND_NOIR) à 7 (FOND_BLANC)
+  byte size : 2;        // 0 (GRANDEUR_NORMALE) à 3 (DOUBLE_GRANDEUR)
+  byte blink : 1;       // CLIGNOTEMENT
+  byte mask : 1;        // MASQUAGE
+  byte underline : 1;   // DEBUT_LIGNAGE (semi-graphique disjoint en mode graphique)
+  byte inverse : 1;     // INVERSION_FOND
+
+  bool operator==(const MinitelCell& c) const {
+    return code == c.code && diacritic == c.diacritic && set == c.set
+        && color == c.color && background == c.background && size == c.size
+        && blink == c.blink && mask == c.mask && underline == c.underline
+        && inverse == c.inverse;
+  }
+  bool operator!=(const MinitelCell& c) const { return !(*this == c); }
+};
+
+////////////////////////////////////////////////////////////////////////
+
+class MinitelScreen
+{
+public:
+  MinitelScreen(Minitel& minitel);
+
+  // Dessin (rien n'est envoyé au Minitel avant commit)
+  void clear();  // Espaces avec les attributs par défaut partout, curseur en 1,1.
+  void moveCursorXY(int x, int y);  // Colonne x (1 à 40) et rangée y (0 à 24).
+  void attributs(byte attribut);  // Mêmes constantes que Minitel::attributs. Attention ! DOUBLE_HAUTEUR ne déplace pas le curseur.
+  void print(String chaine);  // UTF-8 => Cases du jeu G0 ou G2
+  void printChar(char caractere);
+  void printSpecialChar(byte b);  // Jeu G2
+  void graphic(byte b, int x, int y);  // Jeu G1, sous la forme 0b000000 à 0b111111 (voir Minitel::graphic).
+  void graphic(byte b);
+  void setCell(int x, int y, MinitelCell cell);
+  MinitelCell getCell(int x, int y);
+
+  // Envoi
+  void commit();  // Envoie au Minitel les octets qui transforment l'écran affiché en l'écran dessiné.
+  void invalidate();  // Le contenu du Minitel est inconnu : le prochain commit() efface et redessine tout.
+
+private:
+  Minitel* minitel;
+  MinitelCell next[MINITEL_RANGEES][MINITEL_COLONNES];   // Ecran dessiné
+  MinitelCell shown[MINITEL_RANGEES][MINITEL_COLONNES];  // Ecran affiché par le Minitel
+  boolean unknown;
+  int cursorX, cursorY;
+  MinitelCell pen;  // Attributs appliqués aux prochaines cases dessinées
+
+  static MinitelCell blank();
+  void put(byte code, byte diacritic, byte set);
+  void renderRun(int x1, int x2, int y);
+};
+
+////////////////////////////////////////////////////////////////////////
+
+#endif  // Fin Si (MINITEL1B_SCREEN_H)
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Minitel1B_Server - Fichier source - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+   https://entropie.org/3615/
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#if !defined(ARDUINO)  // Uniquement en dehors de l'environnement Arduino
+
+#include "Minitel1B_Server.h"
+#include <sys/epoll.h>
+#include <unistd.h>  // close
+
+#define EVENEMENTS_MAX  64  // Evénements lus par epoll_wait (les suivants attendent le tour d'après)
+
+////////////////////////////////////////////////////////////////////////
+/*
+   Public
+*/
+////////////////////////////////////////////////////////////////////////
+
+MinitelServer::MinitelServer(size_t file, unsigned long periode) : capaciteFile(file), periode(periode) {
+  if (capaciteFile < 2) capaciteFile = 2;  // Voir MinitelTerminal::writable
+  if (this->periode < 1) this->periode = 1;
+  epoll = epoll_create1(EPOLL_CLOEXEC);
+}
+/*--------------------------------------------------------------------*/
+
+MinitelServer::~MinitelServer() {
+  while (!terminaux.empty()) remove(terminaux.back());
+  if (epoll >= 0) ::close(epoll);
+}
+/*--------------------------------------------------------------------*/
+
+MinitelTerminal* MinitelServer::add(MinitelFdTransport& transport, MinitelSession& session) {
+  if (epoll < 0) return NULL;
+  MinitelTerminal* terminal = new MinitelTerminal(transport, session, capaciteFile);  // Minitel ouvre le port (begin).
+  struct epoll_event evenement = {};
+  evenement.events = EPOLLIN;
+  evenement.data.ptr = terminal;
+  if (transport.fd() < 0 || epoll_ctl(epoll, EPOLL_CTL_ADD, transport.fd(), &evenement) != 0) {
+    delete terminal;
+    return NULL;
+  }
+  terminaux.push_back(terminal);
+  session.begin(*terminal);
+  terminal->dernier = millis();
+  terminal->plein = !terminal->writable();
+  watch(terminal);
+  return terminal;
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelServer::remove(MinitelTerminal* terminal) {
+  for (size_t i=0; i<terminaux.size(); i++) {
+    if (terminaux[i] != terminal) continue;
+    terminaux.erase(terminaux.begin() + i);
+    epoll_ctl(epoll, EPOLL_CTL_DEL, terminal->port->fd(), NULL);
+    terminal->application->end(*terminal);
+    delete terminal;
+    return;
+  }
+}
+/*--------------------------------------------------------------------*/
+
+bool MinitelServer::step(int attente) {
+  if (terminaux.empty()) return false;
+  if (attente < 0 || (unsigned long) attente > periode) attente = (int) periode;
+  struct epoll_event evenements[EVENEMENTS_MAX];
+  int n = epoll_wait(epoll, evenements, EVENEMENTS_MAX, attente);
+  for (int i=0; i<n; i++) {
+    MinitelTerminal* terminal = (MinitelTerminal*) evenements[i].data.ptr;
+    if (evenements[i].events & EPOLLOUT) terminal->port->drain();
+    if (evenements[i].events & EPOLLIN) terminal->recu = true;
+    if (evenements[i].events & (EPOLLHUP | EPOLLERR)) terminal->ferme = true;  // Adaptateur débranché, pseudo-terminal fermé...
+  }
+  // loop() de chaque terminal qui a reçu quelque chose, dont la file
+  // d'émission s'est vidée ou dont la période est écoulée
+  unsigned long maintenant = millis();
+  size_t i = 0;
+  while (i < terminaux.size()) {
+    MinitelTerminal* terminal = terminaux[i];
+    if (!terminal->ferme) {
+      boolean place = terminal->plein && terminal->writable();
+      if (terminal->recu || place || maintenant - terminal->dernier >= periode) {
+        terminal->recu = false;
+        terminal->dernier = maintenant;
+        terminal->console.poll();
+        terminal->application->loop(*terminal);
+        terminal->plein = !terminal->writable();
+      }
+      // Octets refusés par une file pleine : l'écran du Minitel n'est plus
+      // celui que la session croit avoir dessiné.
+      if (terminal->port->overflowed()) terminal->ferme = true;
+    }
+    if (terminal->ferme) {
+      remove(terminal);  // Le suivant prend sa place dans terminaux.
+      continue;
+    }
+    watch(terminal);
+    i++;
+  }
+  return !terminaux.empty();
+}
+/*--------------------------------------------------------------------*/
+
+void MinitelServer::run() {
+  while (step(-1));
+}
+/*--------------------------------------------------------------------*/
+
+
+////////////////////////////////////////////////////////////////////////
+/*
+   Privé
+*/
+////////////////////////////////////////////////////////////////////////
+
+void MinitelServer::watch(MinitelTerminal* terminal) {
+  boolean sortie = terminal->port->queued() > 0;
+  if (sortie == terminal->sortie) return;
+  struct epoll_event evenement = {};
+  evenement.events = EPOLLIN;
+  if (sortie) evenement.events |= EPOLLOUT;
+  evenement.data.ptr = terminal;
+  if (epoll_ctl(epoll, EPOLL_CTL_MOD, terminal->port->fd(), &evenement) == 0) terminal->sortie = sortie;
+}
+/*--------------------------------------------------------------------*/
+
+MinitelTerminal::MinitelTerminal(MinitelFdTransport& transport, MinitelSession& session, size_t file)
+  : port(&transport), application(&session), console(transport),
+    recu(false), plein(false), sortie(false), ferme(false), dernier(0) {
+  transport.setOutputQueue(file);
+}
+/*--------------------------------------------------------------------*/
+
+#endif  // Fin Si (!defined(ARDUINO))
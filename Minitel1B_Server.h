@@ -0,0 +1,128 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Minitel1B_Server - Fichier d'en-tête - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+   https://entropie.org/3615/
+
+   Serveur multi-terminaux (Linux seulement) : un seul processus, sans
+   fil d'exécution par terminal, pilote des dizaines de Minitel reliés à
+   autant de ports série, adaptateurs USB ou pseudo-terminaux. Une boucle
+   epoll lit ce que chaque Minitel envoie et vide sa file d'émission au
+   rythme de la ligne.
+
+   Chaque terminal a son objet Minitel (décodage du clavier, requêtes du
+   protocole, suivi du curseur, tampon d'émission), sa file d'émission
+   bornée (voir MinitelFdTransport::setOutputQueue) et sa session : un
+   objet MinitelSession propre à l'application, dont loop() est appelée
+   quand le Minitel a envoyé quelque chose, quand la file d'émission se
+   vide ou à intervalle régulier.
+
+   Une session ne doit pas bloquer la boucle : les fonctions qui attendent
+   une réponse (identifyDevice, changeSpeed, getCursorXY...) sont à
+   remplacer par leur version Async, dont on suit la réponse d'un appel de
+   loop() au suivant avec replyStatus et replyValue. Une page longue part
+   avec beginPage et streamPage (rythme activé), un écran composé attend
+   que writable() le permette. La file d'émission pleine ne fait jamais
+   attendre la boucle : ce qui la dépasse est perdu et le terminal est
+   fermé (session.end()).
+
+   Mémoire par terminal : l'objet Minitel (3 Ko environ), le tampon de
+   réception du port (256 octets) et la file d'émission (4 Ko par défaut),
+   soit moins de 500 Ko pour 64 terminaux.
+
+   Exemple de compilation :
+   g++ -O2 -I. Minitel1B_Soft.cpp Minitel1B_Host.cpp Minitel1B_Server.cpp mon_programme.cpp
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#ifndef MINITEL1B_SERVER_H
+#define MINITEL1B_SERVER_H
+
+#if !defined(ARDUINO)  // Uniquement en dehors de l'environnement Arduino
+
+#include "Minitel1B_Soft.h"
+
+////////////////////////////////////////////////////////////////////////
+
+class MinitelTerminal;
+
+// Application propre à un terminal
+class MinitelSession
+{
+public:
+  virtual ~MinitelSession() {}
+  virtual void begin(MinitelTerminal& terminal) { (void) terminal; }  // Terminal ajouté au serveur
+  virtual void loop(MinitelTerminal& terminal) = 0;  // Octets reçus (déjà lus par poll), file d'émission à moitié vide ou période écoulée
+  virtual void end(MinitelTerminal& terminal) { (void) terminal; }  // Port fermé, close() ou remove()
+};
+
+////////////////////////////////////////////////////////////////////////
+
+class MinitelTerminal
+{
+public:
+  Minitel& minitel() { return console; }
+  MinitelFdTransport& transport() { return *port; }
+  MinitelSession& session() { return *application; }
+  boolean writable() const { return port->queued() <= port->queueCapacity() / 2; }  // La file d'émission est à moitié vide au moins
+  void close() { ferme = true; }  // Le serveur retire le terminal au retour de loop()
+
+private:
+  friend class MinitelServer;
+  MinitelTerminal(MinitelFdTransport& transport, MinitelSession& session, size_t file);
+  MinitelFdTransport* port;
+  MinitelSession* application;
+  Minitel console;
+  boolean recu;  // Événement EPOLLIN en attente de loop()
+  boolean plein;  // La file était pleine au dernier appel de loop()
+  boolean sortie;  // EPOLLOUT demandé
+  boolean ferme;
+  unsigned long dernier;  // millis() au dernier appel de loop()
+};
+
+////////////////////////////////////////////////////////////////////////
+
+class MinitelServer
+{
+public:
+  MinitelServer(size_t file = 4096, unsigned long periode = 50);  // File d'émission de chaque terminal en octets, période en ms entre deux loop() sans événement
+  ~MinitelServer();  // Retire les terminaux restants
+  // Ouvre le port à 1200 bauds, le rend non bloquant et appelle
+  // session.begin(). Le transport et la session ne sont pas copiés : ils
+  // doivent exister jusqu'au retrait du terminal. NULL si le port ne
+  // peut être ouvert.
+  MinitelTerminal* add(MinitelFdTransport& transport, MinitelSession& session);
+  void remove(MinitelTerminal* terminal);  // Appelle session.end(). Pas depuis loop() : voir MinitelTerminal::close.
+  size_t size() const { return terminaux.size(); }
+  MinitelTerminal* terminal(size_t i) { return terminaux[i]; }
+  bool step(int attente);  // Attend un événement au plus attente ms (-1 : la période) et appelle les loop() dus. false sans terminal.
+  void run();  // step() tant qu'il reste des terminaux
+
+private:
+  int epoll;
+  size_t capaciteFile;
+  unsigned long periode;
+  std::vector<MinitelTerminal*> terminaux;
+  void watch(MinitelTerminal* terminal);  // EPOLLOUT selon la file d'émission
+};
+
+////////////////////////////////////////////////////////////////////////
+
+#endif  // Fin Si (!defined(ARDUINO))
+
+#endif  // Fin Si (MINITEL1B_SERVER_H)
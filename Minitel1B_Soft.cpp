@@ -30,35 +30,279 @@
 
 #include "Minitel1B_Soft.h"
 
+#if !defined(ARDUINO)
+#include <string.h>  // memcpy, strlen
+#include <fcntl.h>  // open
+#include <unistd.h>  // close
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <stdio.h>  // fopen (vitesse mémorisée)
+#elif defined(__AVR__)
+#include <EEPROM.h>  // Vitesse mémorisée
+#endif
+
+////////////////////////////////////////////////////////////////////////
+
+// Table de parité paire sur 7 bits, générée à la compilation.
+// PARITE[b] vaut 0x80 si b (0 à 127) comporte un nombre impair de bits à 1
+// et 0x00 sinon : c'est directement le bit 7 à placer dans l'octet émis.
+#define P2(n) n, n^0x80, n^0x80, n
+#define P4(n) P2(n), P2(n^0x80), P2(n^0x80), P2(n)
+#define P6(n) P4(n), P4(n^0x80), P4(n^0x80), P4(n)
+static const byte PARITE[128] PROGMEM = { P6(0x00), P6(0x80) };
+#undef P2
+#undef P4
+#undef P6
+
+static inline byte bitParite(byte b) {
+  return pgm_read_byte(PARITE + (b & 0x7F));
+}
+
+// Motif semi-graphique 0b000000 à 0b111111 (du coin supérieur gauche au
+// coin inférieur droit) => code du jeu G1 (voir p.101). 0x7F, qui n'est
+// pas visualisable, est remplacé par 0x5F (pavé plein).
+static const byte MOSAIQUES[64] PROGMEM = {
+  0x20, 0x60, 0x30, 0x70, 0x28, 0x68, 0x38, 0x78,
+  0x24, 0x64, 0x34, 0x74, 0x2C, 0x6C, 0x3C, 0x7C,
+  0x22, 0x62, 0x32, 0x72, 0x2A, 0x6A, 0x3A, 0x7A,
+  0x26, 0x66, 0x36, 0x76, 0x2E, 0x6E, 0x3E, 0x7E,
+  0x21, 0x61, 0x31, 0x71, 0x29, 0x69, 0x39, 0x79,
+  0x25, 0x65, 0x35, 0x75, 0x2D, 0x6D, 0x3D, 0x7D,
+  0x23, 0x63, 0x33, 0x73, 0x2B, 0x6B, 0x3B, 0x7B,
+  0x27, 0x67, 0x37, 0x77, 0x2F, 0x6F, 0x3F, 0x5F
+};
+
+// Origine de la page en cours d'envoi (voir streamPage)
+#define PAGE_AUCUNE    0
+#define PAGE_MEMOIRE   1
+#define PAGE_FLASH     2
+#define PAGE_FICHIER   3  // Stream (Arduino)
+#define PAGE_PROJETEE  4  // Fichier projeté en mémoire (Linux)
+#define PAGE_COMPRESSEE  5  // MinitelPackedPage
+// Octets de la page envoyés au plus pour atteindre un point de reprise
+// (voir pageBoundary) : de quoi finir une rangée chargée d'attributs. Au-delà,
+// l'écho passe quand même et la page peut en garder une trace.
+#define REPRISE_MAX  160
+
+// Etats de l'analyse des octets émis (voir trackByte)
+#define SUIVI_NORMAL       0
+#define SUIVI_ESC          1
+#define SUIVI_CSI          2
+#define SUIVI_US           3
+#define SUIVI_US2          4
+#define SUIVI_SS2          5
+#define SUIVI_DIACRITIQUE  6
+#define SUIVI_REP          7
+#define SUIVI_PRO          8
+
+// Types de réponses attendues (voir request et matchReply)
+#define REQUETE_VITESSE         1
+#define REQUETE_STANDARD        2
+#define REQUETE_FONCTIONNEMENT  3
+#define REQUETE_CLAVIER         4
+#define REQUETE_AIGUILLAGE      5
+#define REQUETE_MODEM           6
+#define REQUETE_IDENTIFICATION  7
+#define REQUETE_CURSEUR         8
+#define REQUETE_RESERVEE      0xFF  // Place prise avant l'envoi de la commande (voir reserveRequest)
+
+// Recherche de la vitesse (voir searchSpeed) : le délai d'attente de la
+// réponse est la durée de l'échange à la vitesse essayée, plus une marge
+// doublée à chaque tour.
+#define SONDE_OCTETS  7   // PRO1 STATUS_VITESSE, puis PRO2 REP_STATUS_VITESSE vitesse
+#define SONDE_MARGE   60  // En ms
+#define SONDE_TOURS   3
+
+#if defined(MINITEL_LINE_STATS)
+// Contrôle de la vitesse (voir adaptSpeed)
+#define PALIER_REPONSES  4      // Réponses sans erreur avant de monter d'un cran
+#define PALIER_DUREE     10000  // En ms sans erreur, doublé à chaque repli
+#define REPLIS_MAX       5
+#define REPLI_ERREURS    2      // Erreurs de parité et trames perdues...
+#define REPLI_TAUX       64     // ... plus d'une pour 64 octets reçus
+#define REPLI_ECHECS     2      // Réponses attendues en vain
+
+static const int VITESSES[4] = { 300, 1200, 4800, 9600 };
+
+static int rangVitesse(long bauds) {
+  for (int i=0; i<4; i++) {
+    if (VITESSES[i] == bauds) return i;
+  }
+  return -1;
+}
+
+// Compte un événement de la ligne à la vitesse en cours (voir lineStats),
+// sauf pendant searchSpeed : les vitesses essayées en vain ne transportent
+// que des octets sans suite.
+#define COMPTER_LIGNE(champ) do { MinitelLineStats* c = lineCounter(); if (c != NULL && !speedProbing) c->champ++; } while (0)
+#else
+#define COMPTER_LIGNE(champ) do { } while (0)
+#endif
+
+// Etats du décodage des touches (voir decodeKey)
+#define DECODAGE_NORMAL       0
+#define DECODAGE_SS2          1
+#define DECODAGE_DIACRITIQUE  2  // Accent, tréma ou cédille reçu : on attend la lettre.
+#define DECODAGE_IGNORE       3  // Octet suivant ignoré, puis retour à DECODAGE_DIACRITIQUE
+#define DECODAGE_PERDU        4  // Octet suivant ignoré, puis retour à DECODAGE_NORMAL
+#define DECODAGE_SEP          5
+#define DECODAGE_ESC          6  // Cet état et les suivants se terminent aussi au bout
+#define DECODAGE_CSI          7  // de MINITEL_INTER_BYTE_TIMEOUT sans nouvel octet.
+#define DECODAGE_CSI_PARAM    8
+
+// Caractères Unicode visualisables au-delà de 0x7F et leur code Minitel
+// (voir p.90), triés par code Unicode pour la recherche par dichotomie.
+// SS2 (0x19) donne accès au jeu G2, SI (0x0F) au jeu G0.
+struct CaractereVideotex {
+  uint16_t unicode;
+  uint32_t videotex;
+};
+static const CaractereVideotex CARACTERES_VIDEOTEX[] PROGMEM = {
+  { 0x00A3, 0x1923 },    // £ (VGP5 et VGP2)
+  { 0x00A7, 0x1927 },    // § (VGP5 seulement)
+  { 0x00B0, 0x1930 },    // ° (VGP5 et VGP2)
+  { 0x00B1, 0x1931 },    // ± (VGP5 et VGP2)
+  { 0x00BC, 0x193C },    // ¼ (VGP5 et VGP2)
+  { 0x00BD, 0x193D },    // ½ (VGP5 et VGP2)
+  { 0x00BE, 0x193E },    // ¾ (VGP5 et VGP2)
+  // Aucune lettre accentuée majuscule n'est disponible (voir p.90) :
+  // on affiche la lettre sans accent.
+  { 0x00C0, 0x0F41 },    // À
+  { 0x00C2, 0x0F41 },    // Â
+  { 0x00C4, 0x0F41 },    // Ä
+  { 0x00C7, 0x0F43 },    // Ç
+  { 0x00C8, 0x0F45 },    // È
+  { 0x00C9, 0x0F45 },    // É
+  { 0x00CA, 0x0F45 },    // Ê
+  { 0x00CB, 0x0F45 },    // Ë
+  { 0x00CE, 0x0F49 },    // Î
+  { 0x00CF, 0x0F49 },    // Ï
+  { 0x00D4, 0x0F4F },    // Ô
+  { 0x00D6, 0x0F4F },    // Ö
+  { 0x00D9, 0x0F55 },    // Ù
+  { 0x00DB, 0x0F55 },    // Û
+  { 0x00DC, 0x0F55 },    // Ü
+  { 0x00E0, 0x194161 },  // à (VGP5 et VGP2)
+  { 0x00E2, 0x194361 },  // â (VGP5 et VGP2)
+  { 0x00E4, 0x194861 },  // ä (VGP5 seulement)
+  { 0x00E7, 0x194B63 },  // ç (VGP5 et VGP2)
+  { 0x00E8, 0x194165 },  // è (VGP5 et VGP2)
+  { 0x00E9, 0x194265 },  // é (VGP5 et VGP2)
+  { 0x00EA, 0x194365 },  // ê (VGP5 et VGP2)
+  { 0x00EB, 0x194865 },  // ë (VGP5 et VGP2)
+  { 0x00EE, 0x194369 },  // î (VGP5 et VGP2)
+  { 0x00EF, 0x194869 },  // ï (VGP5 et VGP2)
+  { 0x00F4, 0x19436F },  // ô (VGP5 et VGP2)
+  { 0x00F6, 0x19486F },  // ö (VGP5 seulement)
+  { 0x00F7, 0x1938 },    // ÷ (VGP5 et VGP2)
+  { 0x00F9, 0x194175 },  // ù (VGP5 et VGP2)
+  { 0x00FB, 0x194375 },  // û (VGP5 et VGP2)
+  { 0x00FC, 0x194875 },  // ü (VGP5 seulement)
+  { 0x0152, 0x196A },    // Œ (VGP5 et VGP2)
+  { 0x0153, 0x197A },    // œ (VGP5 et VGP2)
+  { 0x03B2, 0x197B },    // β (VGP5 seulement)
+  { 0x2014, 0x60 },      // —
+  { 0x2190, 0x192C },    // ←
+  { 0x2191, 0x5E },      // ↑
+  { 0x2192, 0x192E },    // →
+  { 0x2193, 0x192F }     // ↓
+};
+#define NB_CARACTERES_VIDEOTEX  (sizeof(CARACTERES_VIDEOTEX) / sizeof(CARACTERES_VIDEOTEX[0]))
+
+// Caractères visualisables de U+00A0 à U+00FF (1 bit par caractère, voir
+// MinitelTranscoder::isVisualisable). Les majuscules accentuées n'en font
+// pas partie : elles s'affichent sans accent.
+static const byte VISUALISABLES_LATIN1[12] PROGMEM = {
+  0x88, 0x00, 0x03, 0x70,  // U+00A0 à U+00BF : £ § ° ± ¼ ½ ¾
+  0x00, 0x00, 0x00, 0x00,  // U+00C0 à U+00DF
+  0x95, 0xCF, 0xD0, 0x1A   // U+00E0 à U+00FF : à â ä ç è é ê ë î ï ô ö ÷ ù û ü
+};
+
+// Attributs suivis (voir trackAttr), et leur valeur après US, RS ou FF
+#define ATTR_COULEUR       0
+#define ATTR_FOND          1  // Attribut de zone
+#define ATTR_MASQUAGE      2  // Attribut de zone
+#define ATTR_LIGNAGE       3  // Attribut de zone
+#define ATTR_TAILLE        4
+#define ATTR_CLIGNOTEMENT  5
+#define ATTR_INVERSION     6
+#define ATTR_JEU           7  // SI ou SO
+static const byte ATTR_DEFAUT[8] = {
+  CARACTERE_BLANC, FOND_NOIR, DEMASQUAGE, FIN_LIGNAGE, GRANDEUR_NORMALE, FIXE, FOND_NORMAL, SI
+};
+
+// Attribut (code de la grille C1) => indice dans trackAttr, -1 si non suivi
+static int attrIndex(byte attribut) {
+  if (attribut >= CARACTERE_NOIR && attribut <= CARACTERE_BLANC) return ATTR_COULEUR;
+  if (attribut >= FOND_NOIR && attribut <= FOND_BLANC) return ATTR_FOND;
+  if (attribut >= GRANDEUR_NORMALE && attribut <= DOUBLE_GRANDEUR) return ATTR_TAILLE;
+  switch (attribut) {
+    case CLIGNOTEMENT : case FIXE : return ATTR_CLIGNOTEMENT;
+    case MASQUAGE : case DEMASQUAGE : return ATTR_MASQUAGE;
+    case DEBUT_LIGNAGE : case FIN_LIGNAGE : return ATTR_LIGNAGE;
+    case INVERSION_FOND : case FOND_NORMAL : return ATTR_INVERSION;
+  }
+  return -1;
+}
+
+// Coût en octets d'un déplacement relatif de n cases : n codes simples
+// (BS, HT, LF ou VT) ou CSI Pn suivi du code final.
+static inline int coutRelatif(int n) {
+  if (n < 0) n = -n;
+  int csi = (n > 9) ? 5 : 4;
+  return (n < csi) ? n : csi;
+}
+
+#if defined(MINITEL_STATS)
+// Compte les octets émis par la fonction publique en cours (voir StatsCall)
+#define COMPTER_APPEL(famille)  StatsCall statsAppel(this, famille)
+
+// Sortie de printStats : port série (Arduino) ou fichier (Linux)
+#if defined(ARDUINO)
+static void statsTexte(Print& sortie, const __FlashStringHelper* texte) { sortie.print(texte); }
+static void statsNombre(Print& sortie, unsigned long n) { sortie.print(n); }
+#else
+static void statsTexte(FILE* sortie, const __FlashStringHelper* texte) { fputs(reinterpret_cast<const char*>(texte), sortie); }
+static void statsNombre(FILE* sortie, unsigned long n) { fprintf(sortie, "%lu", n); }
+#endif
+#else
+#define COMPTER_APPEL(famille)
+#endif
+
 ////////////////////////////////////////////////////////////////////////
 /*
    Public
 */
 ////////////////////////////////////////////////////////////////////////
 
-Minitel::Minitel(int rx, int tx) : SoftwareSerial(rx,tx) {
+#if defined(ARDUINO)
+Minitel::Minitel(int rx, int tx) : MinitelSerial(rx,tx) {
+  // A la mise sous tension du Minitel, la vitesse des échanges entre
+  // le Minitel et le périphérique est de 1200 bauds par défaut.
+  begin(1200);
+}
+#else
+Minitel::Minitel(MinitelTransport& transport) : MinitelSerial(transport) {
   // A la mise sous tension du Minitel, la vitesse des échanges entre
   // le Minitel et le périphérique est de 1200 bauds par défaut.
   begin(1200);
 }
 /*--------------------------------------------------------------------*/
 
+Minitel::~Minitel() {
+  endPage();  // Libère un fichier projeté en mémoire
+}
+#endif
+
+/*--------------------------------------------------------------------*/
+
 void Minitel::writeByte(byte b) {
-  // Le bit de parité est mis à 0 si la somme des autres bits est paire
-  // et à 1 si elle est impaire.
-  boolean parite = 0;
-  for (int i=0; i<7; i++) {
-    if (bitRead(b,i) == 1)  {
-      parite = !parite;
-    }
-  }
-  if (parite) {
-    bitWrite(b,7,1);  // Ecriture du bit de parité
-  }
-  else {
-    bitWrite(b,7,0);  // Ecriture du bit de parité
+  b &= 0x7F;
+  if (autoRepeat && repeatByte(b)) {  // Octet mis en attente dans une répétition
+    if (txHold == 0 && txCount + repeatCount >= txThreshold) flush();
+    return;
   }
-  write(b);  // Envoi de l'octet sur le port série
+  sendByte(b);
 }
 /*--------------------------------------------------------------------*/
 
@@ -83,38 +327,437 @@ void Minitel::writeCode(unsigned long code) {
 }
 /*--------------------------------------------------------------------*/
 
+void Minitel::writeBytes(const byte* buffer, size_t size) {
+  // Les octets sont envoyés sur la ligne en un seul bloc
+  // (ou en autant de blocs que nécessaire si le tampon est plus petit).
+  if (autoRepeat) {
+    // Au moins 4 caractères identiques à la suite : on passe par writeByte
+    // pour que la répétition soit codée par REP.
+    for (size_t i=3; i<size; i++) {
+      byte b = buffer[i] & 0x7F;
+      if (b >= SP && b == (buffer[i-1] & 0x7F) && b == (buffer[i-2] & 0x7F) && b == (buffer[i-3] & 0x7F)) {
+        holdFlush();
+        for (size_t j=0; j<size; j++) writeByte(buffer[j]);
+        releaseFlush();
+        return;
+      }
+    }
+  }
+  sendBytes(buffer, size);
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::sendBytes(const byte* buffer, size_t size) {
+  // Equivalent de sendByte pour un bloc : la parité est calculée
+  // directement dans le tampon d'émission.
+  flushRepeat();
+  repeatChar = 0;
+  for (size_t i=0; i<size; i++) trackByte(buffer[i] & 0x7F);
+  holdFlush();
+  while (size > 0) {
+    if (txCount == MINITEL_TX_BUFFER_SIZE) flush();
+    size_t fin = (txStart + txCount) % MINITEL_TX_BUFFER_SIZE;
+    size_t n = MINITEL_TX_BUFFER_SIZE - txCount;  // Place libre...
+    if (n > MINITEL_TX_BUFFER_SIZE - fin) n = MINITEL_TX_BUFFER_SIZE - fin;  // ...et contiguë
+    if (n > size) n = size;
+    if (nativeParity) {
+      for (size_t i=0; i<n; i++) txBuffer[fin+i] = buffer[i] & 0x7F;
+    }
+    else {
+      encodeParity(buffer, txBuffer + fin, n);
+    }
+    txCount += n;
+    buffer += n;
+    size -= n;
+  }
+  releaseFlush();
+}
+/*--------------------------------------------------------------------*/
+
 byte Minitel::readByte() {
   byte b = read();
+#if defined(MINITEL_STATS)
+  statsData.received++;
+#endif
+  if (nativeParity) {  // Le port a déjà vérifié la parité et écarté les octets erronés.
+    return b & 0x7F;
+  }
   // Le bit de parité est à 0 si la somme des autres bits est paire
   // et à 1 si elle est impaire.
-  boolean parite = 0;
-  for (int i=0; i<7; i++) {
-    if (bitRead(b,i) == 1)  {
-      parite = !parite;
+  if ((b & 0x80) == bitParite(b)) {  // La transmission est bonne, on peut récupérer la donnée.
+    return b & 0x7F;  // On met le bit de parité à 0 afin de récupérer la donnée.
+  }
+  else {
+    parityErrorCount++;
+    return 0xFF;  // Pour indiquer une erreur de parité.
+  }
+}
+/*--------------------------------------------------------------------*/
+
+bool Minitel::setNativeParity(bool actif) {
+  flush();  // Ce qui est en attente a été préparé pour l'ancien format
+#if defined(ARDUINO)
+  // SoftwareSerial ne connaît que le format 8N1. Pour un port série
+  // matériel (SERIAL_7E1), voir la bibliothèque Minitel1B_Hard.
+  if (actif) return false;
+#else
+  if (!MinitelSerial::nativeParity(actif)) return false;
+#endif
+  nativeParity = actif;
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+unsigned long Minitel::parityErrors() {
+#if defined(ARDUINO)
+  return parityErrorCount;
+#else
+  return parityErrorCount + MinitelSerial::parityErrors();
+#endif
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::encodeParity(const byte* source, byte* destination, size_t size) {
+  // Ajoute le bit de parité paire à size octets (source et destination
+  // peuvent être confondues).
+  size_t i = 0;
+#if !defined(ARDUINO)
+  // Sur un PC, on traite 8 octets à la fois dans un mot de 64 bits :
+  // les décalages successifs replient les 7 bits de chaque octet sur son
+  // bit 0 sans jamais déborder sur l'octet voisin.
+  for (; i + 8 <= size; i += 8) {
+    uint64_t x;
+    memcpy(&x, source + i, 8);
+    x &= 0x7F7F7F7F7F7F7F7FULL;
+    uint64_t p = x ^ (x >> 4);
+    p ^= p >> 2;
+    p ^= p >> 1;
+    x |= (p & 0x0101010101010101ULL) << 7;
+    memcpy(destination + i, &x, 8);
+  }
+#endif
+  for (; i < size; i++) {
+    destination[i] = (source[i] & 0x7F) | bitParite(source[i]);
+  }
+}
+/*--------------------------------------------------------------------*/
+
+size_t Minitel::decodeParity(const byte* source, byte* destination, size_t size) {
+  // Retire le bit de parité de size octets. Comme readByte(), un octet
+  // erroné est remplacé par 0xFF. Renvoie le nombre d'erreurs de parité.
+  size_t erreurs = 0;
+  size_t i = 0;
+#if !defined(ARDUINO)
+  for (; i + 8 <= size; i += 8) {
+    uint64_t x;
+    memcpy(&x, source + i, 8);
+    uint64_t d = x & 0x7F7F7F7F7F7F7F7FULL;
+    uint64_t p = d ^ (d >> 4);
+    p ^= p >> 2;
+    p ^= p >> 1;
+    // 0x01 dans chaque octet dont le bit 7 ne correspond pas à la parité
+    uint64_t e = ((x >> 7) ^ p) & 0x0101010101010101ULL;
+    if (e) {
+      erreurs += __builtin_popcountll(e);
+      d |= e * 0xFF;
+    }
+    memcpy(destination + i, &d, 8);
+  }
+#endif
+  for (; i < size; i++) {
+    byte b = source[i];
+    if ((b & 0x80) == bitParite(b)) {
+      destination[i] = b & 0x7F;
+    }
+    else {
+      destination[i] = 0xFF;
+      erreurs++;
+    }
+  }
+  return erreurs;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::flush() {
+  flushRepeat();
+  while (txCount > 0) {
+    // Le tampon est circulaire : on envoie d'abord la partie contiguë.
+    size_t n = txCount;
+    if (txStart + n > MINITEL_TX_BUFFER_SIZE) {
+      n = MINITEL_TX_BUFFER_SIZE - txStart;
+    }
+    size_t envoyes = MinitelSerial::write(txBuffer + txStart, n);
+    if (envoyes == 0) {  // Le port n'accepte plus rien : on abandonne le contenu du tampon.
+      txCount = 0;
+      break;
+    }
+    txStart = (txStart + envoyes) % MINITEL_TX_BUFFER_SIZE;
+    txCount -= envoyes;
+  }
+  txStart = 0;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::setAutoRepeat(boolean actif) {
+  flushRepeat();
+  repeatChar = 0;
+  autoRepeat = actif;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::setAutoFlush(size_t seuil) {
+  if (seuil < 1) seuil = 1;
+  if (seuil > MINITEL_TX_BUFFER_SIZE) seuil = MINITEL_TX_BUFFER_SIZE;
+  txThreshold = seuil;
+  if (txHold == 0 && txCount >= txThreshold) flush();
+}
+/*--------------------------------------------------------------------*/
+
+size_t Minitel::pendingBytes() {
+  return txCount;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::beginPage(const byte* page, size_t size) {
+  startPage(PAGE_MEMOIRE, page, size);
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::beginPage_P(const byte* page, size_t size) {
+  startPage(PAGE_FLASH, page, size);
+}
+/*--------------------------------------------------------------------*/
+
+#if defined(ARDUINO)
+void Minitel::beginPage(Stream& fichier) {
+  startPage(PAGE_FICHIER, NULL, fichier.available());  // Pour un fichier : ce qui reste à lire
+  pageFile = &fichier;
+}
+#else
+bool Minitel::beginPage(const char* fichier) {
+  endPage();
+  int fd = ::open(fichier, O_RDONLY);
+  if (fd < 0) return false;
+  struct stat infos;
+  if (fstat(fd, &infos) < 0) {
+    ::close(fd);
+    return false;
+  }
+  size_t size = (size_t) infos.st_size;
+  void* page = NULL;
+  if (size > 0) {  // mmap refuse une longueur nulle
+    page = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (page == MAP_FAILED) {
+      ::close(fd);
+      return false;
     }
+    madvise(page, size, MADV_SEQUENTIAL);
   }
-  if (bitRead(b,7) == parite) {  // La transmission est bonne, on peut récupérer la donnée.
-    if (bitRead(b,7) == 1) {  // Cas où le bit de parité vaut 1.
-      b = b ^ 0b10000000;  // OU exclusif pour mettre le bit de parité à 0 afin de récupérer la donnée.
+  ::close(fd);  // La projection reste valable sans le descripteur.
+  startPage(PAGE_PROJETEE, (const byte*) page, size);
+  return true;
+}
+#endif
+/*--------------------------------------------------------------------*/
+
+void Minitel::beginPage(MinitelPackedPage& page) {
+  startPage(PAGE_COMPRESSEE, NULL, page.length());
+  pagePacked = &page;
+}
+/*--------------------------------------------------------------------*/
+
+boolean Minitel::streamPage() {
+  if (pageSource == PAGE_AUCUNE) return false;
+  COMPTER_APPEL(STATS_APPEL_PAGE);
+  if (pageCancelKeys) {
+    poll();
+    for (byte i=0; i<keyCount; i++) {
+      unsigned long code = keyEvents[(keyStart + i) % MINITEL_KEY_EVENTS].code;
+      if (code == ANNULATION || code == RETOUR || code == SOMMAIRE) {
+        endPage();
+        return false;
+      }
     }
-    return b;
+  }
+  if (statusText != NULL) sendStatus();
+  if (pageSource == PAGE_AUCUNE) return false;  // Page terminée pour atteindre un point de reprise
+  size_t n = pageSize - pageOffset;
+  if (n > MINITEL_PAGE_CHUNK) n = MINITEL_PAGE_CHUNK;
+  if (pagePacing) {
+    // Le crédit se compte en millièmes de bit : la ligne en écoule lineSpeed
+    // par milliseconde, un octet en coûte 10000 (départ, 7 bits, parité,
+    // arrêt). Il ne dépasse ni un bloc, ni ce que la ligne écoule en
+    // pageLatency ms : après une pause, pas de rafale, et ce qui est écrit
+    // entre deux appels n'attend jamais plus longtemps.
+    unsigned long plafond = pageLatency * lineSpeed;
+    if (plafond > MINITEL_PAGE_CHUNK * 10000UL) plafond = MINITEL_PAGE_CHUNK * 10000UL;
+    if (plafond < 10000) plafond = 10000;
+    unsigned long maintenant = millis();
+    unsigned long ecoule = maintenant - pageClock;
+    pageClock = maintenant;
+    if (ecoule > 60000UL) ecoule = 60000UL;
+    pageCredit += ecoule * lineSpeed;
+    if (pageCredit > plafond) pageCredit = plafond;
+    if (n > pageCredit / 10000) n = pageCredit / 10000;
+    if (n == 0) return true;  // La ligne est encore occupée.
+    pageCredit -= n * 10000UL;
+  }
+  if (pageSource == PAGE_MEMOIRE || pageSource == PAGE_PROJETEE) {
+    sendBytes(pageData + pageOffset, n);
   }
   else {
-    return 0xFF;  // Pour indiquer une erreur de parité.
+    byte bloc[MINITEL_PAGE_CHUNK];
+    n = pageRead(bloc, n);
+    if (n == 0) {  // Page plus courte que prévu
+      endPage();
+      return false;
+    }
+    sendBytes(bloc, n);
+  }
+  flush();
+  pageOffset += n;
+  if (pageOffset >= pageSize) {
+    endPage();
+    return false;
+  }
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::endPage() {
+  // Une page abandonnée s'arrête après la séquence en cours : la suite
+  // (autre page, écho...) ne doit pas en devenir un paramètre.
+  if (pageSource != PAGE_AUCUNE && pageOffset > 0 && pageOffset < pageSize) {
+    pageBoundary(false);
+    flush();
   }
+#if !defined(ARDUINO)
+  if (pageSource == PAGE_PROJETEE && pageSize > 0) munmap((void*) pageData, pageSize);
+#endif
+  pageSource = PAGE_AUCUNE;
+  pageData = NULL;
+#if defined(ARDUINO)
+  pageFile = NULL;
+#endif
+  pagePacked = NULL;
+  pageLookahead = -1;
+}
+/*--------------------------------------------------------------------*/
+
+size_t Minitel::pageProgress() {
+  return pageOffset;
+}
+/*--------------------------------------------------------------------*/
+
+size_t Minitel::pageLength() {
+  return pageSize;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::setPagePacing(boolean actif) {
+  pagePacing = actif;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::setPageLatency(unsigned long ms) {
+  pageLatency = ms;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::beginOverlay() {
+  if (overlayDepth++ > 0) return;
+  if (pageSource != PAGE_AUCUNE) {
+    // Sans attendre le Minitel (getCursorXY) : la page est envoyée jusqu'à
+    // une position connue. Si elle n'en donne pas, l'écho passe quand même
+    // et la page reprend là où il s'arrête.
+    pageBoundary(true);
+  }
+  flushRepeat();
+  overlayX = trackX;
+  overlayY = trackY;
+  overlayKnown = trackKnown;
+  for (int i=0; i<8; i++) overlayAttr[i] = trackAttr[i];
+  for (int i=0; i<3; i++) overlayZone[i] = (pageSource != PAGE_AUCUNE) ? trackZone[i] : 0;  // Voir pageSafe
+  holdFlush();
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::endOverlay() {
+  if (overlayDepth == 0 || --overlayDepth > 0) return;
+  flushRepeat();
+  if (overlayKnown) {
+    if (overlayY == 0) newXY(overlayX, 0);
+    else moveCursorXY(overlayX, overlayY);
+    // Attributs de zone validés par la page : une espace les valide de
+    // nouveau sur la case que la page va écrire, puis on revient dessus.
+    int suivant = pagePeek() & 0x7F;
+    byte zone[3];
+    boolean change = false;
+    for (int i=0; i<3; i++) {
+      zone[i] = (overlayZone[i] != 0) ? overlayZone[i] : ATTR_DEFAUT[ATTR_FOND + i];  // Voir pageSafe
+      if (zone[i] != trackZone[i]) change = true;
+    }
+    if (change && overlayZone[0] != 0 && overlayAttr[ATTR_JEU] == SI && suivant != 0x20
+        && overlayX < trackColumns && overlayY > 0) {
+      if (trackAttr[ATTR_JEU] != SI) writeByte(SI);
+      if (trackAttr[ATTR_TAILLE] != GRANDEUR_NORMALE) {
+        writeByte(ESC);
+        writeByte(GRANDEUR_NORMALE);
+      }
+      for (int i=0; i<3; i++) {
+        if (trackAttr[ATTR_FOND + i] != zone[i]) {
+          writeByte(ESC);
+          writeByte(zone[i]);
+        }
+      }
+      writeByte(SP);
+      writeByte(BS);
+    }
+  }
+  // Le jeu d'abord : il donne leur sens aux attributs qui suivent.
+  if (overlayAttr[ATTR_JEU] != 0 && trackAttr[ATTR_JEU] != overlayAttr[ATTR_JEU]) writeByte(overlayAttr[ATTR_JEU]);
+  for (int i=0; i<ATTR_JEU; i++) {
+    byte attribut = overlayAttr[i];
+    // Masquage ou lignage inconnu : celui par défaut, s'il a pu être changé
+    if (attribut == 0 && (i == ATTR_MASQUAGE || i == ATTR_LIGNAGE) && trackAttr[i] != 0) attribut = ATTR_DEFAUT[i];
+    if (attribut != 0 && trackAttr[i] != attribut) {
+      writeByte(ESC);  // Sans le déplacement d'attributs() après une double hauteur
+      writeByte(attribut);
+    }
+  }
+  releaseFlush();
+  flush();
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::setStatus(const char* texte) {
+  statusText = texte;  // NULL : abandonne le texte en attente
+  if (statusText != NULL && pageSource == PAGE_AUCUNE) sendStatus();  // Sinon au prochain streamPage
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::setPageCancelKeys(boolean actif) {
+  pageCancelKeys = actif;
+}
+/*--------------------------------------------------------------------*/
+
+unsigned long Minitel::identifyDevice() {
+  return waitReply(identifyDeviceAsync(NULL));  // 0 sans réponse
 }
 /*--------------------------------------------------------------------*/
 
-unsigned long Minitel::identifyDevice() {  // Voir p.139
+int Minitel::identifyDeviceAsync(MinitelCallback callback) {  // Voir p.139
   // Fonction proposée par iodeo sur GitHub en février 2023
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Demande
   writeBytesPRO(1);  // 0x1B 0x39
   writeByte(ENQROM);  // 0x7B
   // Réponse
-  return identificationBytes();  // 3 octets
-                                 // octet définissant le constructeur du Minitel
-                                 // octet définissant le type du Minitel
-                                 // octet définissant la version du logiciel
+  return request(i, REQUETE_IDENTIFICATION, 0, callback);  // 3 octets
+                                                        // octet définissant le constructeur du Minitel
+                                                        // octet définissant le type du Minitel
+                                                        // octet définissant la version du logiciel
 
   // Codes d'identification de l'octet de poids fort :
   /*
@@ -138,8 +781,18 @@ unsigned long Minitel::identifyDevice() {  // Voir p.139
 }
 /*--------------------------------------------------------------------*/
 
-int Minitel::changeSpeed(int bauds) {  // Voir p.141
+int Minitel::changeSpeed(int bauds) {
+  unsigned long reponse = waitReply(changeSpeedAsync(bauds, NULL));
+  if (reponse > 0) writeSpeedCache((int) reponse);
+  return (reponse > 0) ? (int) reponse : -1;  // En bauds, -1 sans réponse
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::changeSpeedAsync(int bauds, MinitelCallback callback) {  // Voir p.141
   // Fonction modifiée par iodeo sur GitHub en octobre 2021
+  if (bauds != 300 && bauds != 1200 && bauds != 4800 && bauds != 9600) return -1;
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Format de la commande
   writeBytesPRO(2);  // 0x1B 0x3A
   writeByte(PROG);   // 0x6B
@@ -149,46 +802,247 @@ int Minitel::changeSpeed(int bauds) {  // Voir p.141
     case 4800 : writeByte(0b1110110); break;  // 0x76
     case 9600 : writeByte(0b1111111); break;  // 0x7F (pour le Minitel 2 seulement)
   }
+  flush();  // La commande doit partir à l'ancienne vitesse
   #if defined(ESP32) || defined(ARDUINO_ARCH_ESP32)
-  flush(false); // Patch pour Arduino-ESP32 core v1.0.6 https://github.com/espressif/arduino-esp32
+  MinitelSerial::flush(false); // Patch pour Arduino-ESP32 core v1.0.6 https://github.com/espressif/arduino-esp32
   #endif
   end();
   begin(bauds);
+  lineSpeed = bauds;
   // Acquittement
-  return workingSpeed();  // En bauds (voir section Private ci-dessous)
+  return request(i, REQUETE_VITESSE, 0, callback);
 }
 /*--------------------------------------------------------------------*/
 
-int Minitel::currentSpeed() {  // Voir p.141
+int Minitel::currentSpeed() {
+  unsigned long bauds = waitReply(currentSpeedAsync(NULL));
+  if (bauds > 0) lineSpeed = bauds;  // Rythme des pages (voir streamPage)
+  return (bauds > 0) ? (int) bauds : -1;  // En bauds, -1 sans réponse
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::currentSpeedAsync(MinitelCallback callback) {  // Voir p.141
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Demande
   writeBytesPRO(1);
   writeByte(STATUS_VITESSE);
   // Réponse
-  return workingSpeed();  // En bauds (voir section Private ci-dessous)
+  return request(i, REQUETE_VITESSE, 0, callback);
 }
 /*--------------------------------------------------------------------*/
 
 int Minitel::searchSpeed() {
   const int SPEED[4] = { 1200, 4800, 300, 9600 };  // 9600 bauds pour le Minitel 2 seulement
-  int i = 0;
-  int speed;
-  do {
-    begin(SPEED[i]);
-    if (i++ > 3) { i = 0; }
-    speed = currentSpeed();
-  } while (speed < 0);
-  return speed;  // En bauds
+  int memorisee = readSpeedCache();  // Essayée en premier
+  unsigned long delai = replyTimeout;
+  int speed = -1;
+  flush();  // Ce qui est en attente doit partir à la vitesse actuelle
+  speedProbing = true;
+  for (int tour=0; tour<SONDE_TOURS && speed < 0; tour++) {
+    for (int i=-1; i<4 && speed < 0; i++) {
+      int bauds = (i < 0) ? memorisee : SPEED[i];
+      if (bauds <= 0 || (i >= 0 && bauds == memorisee)) continue;
+      begin(bauds);
+      lineSpeed = bauds;
+      replyTimeout = SONDE_OCTETS * 10000UL / bauds + ((unsigned long) SONDE_MARGE << tour);
+      speed = currentSpeed();
+    }
+  }
+  replyTimeout = delai;
+  speedProbing = false;
+#if defined(MINITEL_LINE_STATS)
+  lineParity = parityErrors();  // Les erreurs des vitesses essayées ne sont pas réparties.
+#endif
+  if (speed > 0) writeSpeedCache(speed);
+  return speed;  // En bauds, -1 sans réponse
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::negotiateSpeed(int maximum) {
+  int speed = searchSpeed();
+  if (speed < 0) return -1;
+  // Vitesse la plus rapide du modèle (voir identifyDeviceAsync)
+  unsigned long delai = replyTimeout;
+  replyTimeout = 2 * SONDE_OCTETS * 10000UL / speed + SONDE_MARGE;  // 8 octets échangés
+  unsigned long identification = identifyDevice();
+  replyTimeout = delai;
+  if (identification == 0) return speed;  // Modèle inconnu : on reste à cette vitesse.
+  byte type = (identification >> 8) & 0xFF;
+  int plafond = (type == 0x76 || type == 0x7A) ? 9600 : 4800;  // Minitel 2 et Minitel 12
+  speedCeiling = plafond;
+  if (plafond > maximum) plafond = (maximum >= 4800) ? 4800 : (maximum >= 1200) ? 1200 : 300;
+  if (plafond == speed) return speed;
+  int nouvelle = changeSpeed(plafond);
+  return (nouvelle > 0) ? nouvelle : searchSpeed();  // Sans acquittement, on ne sait plus où en est le Minitel.
+}
+/*--------------------------------------------------------------------*/
+
+#if defined(MINITEL_LINE_STATS)
+MinitelLineStats Minitel::lineStats(int bauds) {
+  int k = rangVitesse((bauds == 0) ? lineSpeed : bauds);
+  if (k < 0) {
+    MinitelLineStats vide = {};
+    return vide;
+  }
+  poll();  // Erreurs de parité pas encore réparties
+  return lineCounters[k];
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::resetLineStats() {
+  for (int k=0; k<4; k++) {
+    MinitelLineStats vide = {};
+    lineCounters[k] = vide;
+  }
+  lineParity = parityErrors();
+  adaptSpeedValue = 0;
+  adaptFallbacks = 0;
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::adaptSpeed(int maximum) {
+  int k = rangVitesse(lineSpeed);
+  if (k < 0) return (int) lineSpeed;
+  if (adaptSpeedValue != lineSpeed) {  // Vitesse changée depuis : nouvelle période
+    adaptSpeedValue = lineSpeed;
+    adaptStart = lineCounters[k];
+    adaptTime = millis();
+  }
+  // Sans assez d'échanges depuis le début de la période, une demande de
+  // vitesse (4 octets dans chaque sens) en ajoute un.
+  unsigned long delai = replyTimeout;
+  replyTimeout = SONDE_OCTETS * 10000UL / lineSpeed + SONDE_MARGE;
+  if (lineCounters[k].replies - adaptStart.replies < PALIER_REPONSES) currentSpeed();
+  poll();
+  MinitelLineStats& s = lineCounters[k];
+  unsigned long recus = s.received - adaptStart.received;
+  unsigned long erreurs = (s.parityErrors - adaptStart.parityErrors) + (s.resyncs - adaptStart.resyncs);
+  unsigned long echecs = s.timeouts - adaptStart.timeouts;
+  unsigned long reponses = s.replies - adaptStart.replies;
+  boolean periodeFinie = (millis() - adaptTime >= ((unsigned long) PALIER_DUREE << adaptFallbacks));
+  int cible = (int) lineSpeed;
+  if (echecs >= REPLI_ECHECS || (erreurs >= REPLI_ERREURS && erreurs * REPLI_TAUX > recus)) {
+    if (k > 0) cible = VITESSES[k-1];
+    if (adaptFallbacks < REPLIS_MAX) adaptFallbacks++;
+    adaptSpeedValue = 0;  // Nouvelle période, même sans changement de vitesse
+  }
+  else if (periodeFinie) {
+    if (erreurs == 0 && echecs == 0 && reponses >= PALIER_REPONSES && k < 3) {
+      if (speedCeiling == 0) {  // Modèle pas encore identifié
+        unsigned long identification = identifyDevice();
+        byte type = (identification >> 8) & 0xFF;
+        if (identification != 0) speedCeiling = (type == 0x76 || type == 0x7A) ? 9600 : 4800;
+      }
+      if (VITESSES[k+1] <= speedCeiling && VITESSES[k+1] <= maximum) cible = VITESSES[k+1];
+    }
+    adaptSpeedValue = 0;  // Les erreurs anciennes ne comptent plus.
+  }
+  replyTimeout = delai;
+  if (cible == lineSpeed) {
+    return (echecs >= REPLI_ECHECS && reponses == 0) ? searchSpeed() : (int) lineSpeed;
+  }
+  int nouvelle = changeSpeed(cible);
+  return (nouvelle > 0) ? nouvelle : searchSpeed();  // Sans acquittement, on ne sait plus où en est le Minitel.
+}
+/*--------------------------------------------------------------------*/
+#endif
+
+#if defined(MINITEL_STATS)
+void Minitel::resetStats() {
+  MinitelStats vide = {};
+  statsData = vide;
+}
+/*--------------------------------------------------------------------*/
+
+unsigned long Minitel::wireTime(unsigned long octets) {
+  // 10 bits par octet (départ, 7 bits de données, parité, arrêt)
+  return octets / lineSpeed * 10000UL + (octets % lineSpeed) * 10000UL / lineSpeed;
+}
+/*--------------------------------------------------------------------*/
+
+#if defined(ARDUINO)
+void Minitel::printStats(Print& sortie) {
+#else
+void Minitel::printStats(FILE* sortie) {
+#endif
+  const __FlashStringHelper* categories[STATS_CATEGORIES] = {
+    F("  curseur     "), F("  attributs   "), F("  texte       "), F("  mosaique    "), F("  protocole   ")
+  };
+  const __FlashStringHelper* familles[STATS_APPELS] = {
+    F("  curseur     "), F("  attributs   "), F("  texte       "), F("  graphic     "),
+    F("  geometrie   "), F("  effacements "), F("  page        ")
+  };
+  const __FlashStringHelper* requetes[STATS_REQUETES] = {
+    F("  identifyDevice "), F("  changeSpeed    "), F("  getCursorXY    ")
+  };
+  unsigned long total = 0;
+  for (int i=0; i<STATS_CATEGORIES; i++) total += statsData.sent[i];
+  statsTexte(sortie, F("Octets emis : "));
+  statsNombre(sortie, total);
+  statsTexte(sortie, F(" ("));
+  statsNombre(sortie, wireTime(total));
+  statsTexte(sortie, F(" ms a "));
+  statsNombre(sortie, lineSpeed);
+  statsTexte(sortie, F(" bauds)\n"));
+  for (int i=0; i<STATS_CATEGORIES; i++) {
+    statsTexte(sortie, categories[i]);
+    statsNombre(sortie, statsData.sent[i]);
+    statsTexte(sortie, F(" octets, "));
+    statsNombre(sortie, wireTime(statsData.sent[i]));
+    statsTexte(sortie, F(" ms\n"));
+  }
+  statsTexte(sortie, F("Octets recus : "));
+  statsNombre(sortie, statsData.received);
+  statsTexte(sortie, F(", dont reponses : "));
+  statsNombre(sortie, statsData.replyBytes);
+  statsTexte(sortie, F("\nAppels :\n"));
+  for (int i=0; i<STATS_APPELS; i++) {
+    statsTexte(sortie, familles[i]);
+    statsNombre(sortie, statsData.calls[i]);
+    statsTexte(sortie, F(" appels, "));
+    statsNombre(sortie, statsData.callBytes[i]);
+    statsTexte(sortie, F(" octets, "));
+    statsNombre(sortie, wireTime(statsData.callBytes[i]));
+    statsTexte(sortie, F(" ms\n"));
+  }
+  statsTexte(sortie, F("Temps de reponse (min / moyen / max) :\n"));
+  for (int i=0; i<STATS_REQUETES; i++) {
+    const MinitelLatency& l = statsData.latency[i];
+    statsTexte(sortie, requetes[i]);
+    statsNombre(sortie, l.replies);
+    statsTexte(sortie, F(" reponses, "));
+    statsNombre(sortie, l.timeouts);
+    statsTexte(sortie, F(" echecs"));
+    if (l.replies > 0) {
+      statsTexte(sortie, F(", "));
+      statsNombre(sortie, l.fastest);
+      statsTexte(sortie, F(" / "));
+      statsNombre(sortie, l.total / l.replies);
+      statsTexte(sortie, F(" / "));
+      statsNombre(sortie, l.slowest);
+      statsTexte(sortie, F(" ms"));
+    }
+    statsTexte(sortie, F("\n"));
+  }
 }
 /*--------------------------------------------------------------------*/
+#endif
 
 void Minitel::newScreen() {
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeByte(FF);
-  currentSize = GRANDEUR_NORMALE;
 }
 /*--------------------------------------------------------------------*/
 
 void Minitel::newXY(int x, int y) {
-  if (x==1 && y==1) {
+  COMPTER_APPEL(STATS_APPEL_CURSEUR);
+  flushRepeat();  // Le suivi des attributs doit être à jour
+  if (y >= 1 && attributesAtDefault()) {
+    // Rien à réinitialiser : le plus court déplacement suffit.
+    moveCursorXY(x,y);
+  }
+  else if (x==1 && y==1) {
     writeByte(RS);
   }
   else {
@@ -201,7 +1055,6 @@ void Minitel::newXY(int x, int y) {
     writeByte(0x40 + y);  // Numéro de rangée
     writeByte(0x40 + x);  // Numéro de colonne
   }
-  currentSize = GRANDEUR_NORMALE;
 }
 /*--------------------------------------------------------------------*/
 
@@ -216,15 +1069,69 @@ void Minitel::noCursor() {
 /*--------------------------------------------------------------------*/
 
 void Minitel::moveCursorXY(int x, int y) {  // Voir p.95
-  writeWord(CSI);   // 0x1B 0x5B
-  writeBytesP(y);   // Pr : Voir section Private ci-dessous
-  writeByte(0x3B);
-  writeBytesP(x);   // Pc : Voir section Private ci-dessous
-  writeByte(0x48);
+  COMPTER_APPEL(STATS_APPEL_CURSEUR);
+  flushRepeat();  // Le suivi du curseur doit être à jour
+  // Une touche reçue avec l'écho actif a pu déplacer le curseur.
+  if (trackEcho && (available() > 0 || rxLength > 0)) invalidateCursor();
+  // Trois points de départ possibles pour un déplacement relatif : la
+  // position courante, le début de la rangée (CR) ou la fin de la rangée
+  // précédente (BS depuis la première colonne). Les déplacements relatifs
+  // ne franchissent jamais un bord de l'écran, ni la rangée 0.
+  // Si les attributs sont à leur valeur par défaut, RS et US, qui les
+  // réinitialisent, sont utilisables aussi.
+  int meilleur = -1;  // -1 : adressage absolu CSI Pr ; Pc H
+  int coutMin = 4 + (y>9 ? 2 : 1) + (x>9 ? 2 : 1);
+  if (y >= 1 && y <= 24 && x >= 1 && x <= trackColumns && attributesAtDefault()) {
+    int c = (x==1 && y==1) ? 1 : 3;
+    if (c < coutMin) {
+      coutMin = c;
+      meilleur = 3;
+    }
+  }
+  if (trackKnown && trackY >= 1 && y >= 1 && y <= 24 && x >= 1 && x <= trackColumns) {
+    int departX[3] = { trackX, 1, trackColumns };
+    int departY[3] = { trackY, trackY, (trackY > 1) ? trackY-1 : 24 };  // En mode page, BS en 1,1 mène en 40,24
+    for (int i=0; i<3; i++) {
+      if (i == 2 && (trackX != 1 || (trackY == 1 && trackScroll))) break;
+      int c = (i > 0 ? 1 : 0) + coutRelatif(x - departX[i]) + coutRelatif(y - departY[i]);
+      if (c < coutMin) {
+        coutMin = c;
+        meilleur = i;
+      }
+    }
+  }
+  holdFlush();
+  if (meilleur < 0) {
+    writeWord(CSI);   // 0x1B 0x5B
+    writeBytesP(y);   // Pr : Voir section Private ci-dessous
+    writeByte(0x3B);
+    writeBytesP(x);   // Pc : Voir section Private ci-dessous
+    writeByte(0x48);
+  }
+  else if (meilleur == 3) {
+    if (x==1 && y==1) {
+      writeByte(RS);
+    }
+    else {
+      writeByte(US);
+      writeByte(0x40 + y);
+      writeByte(0x40 + x);
+    }
+  }
+  else {
+    if (meilleur == 1) writeByte(CR);
+    if (meilleur == 2) writeByte(BS);
+    if (x >= trackX) moveRelative(x - trackX, HT, 0x43);
+    else moveRelative(trackX - x, BS, 0x44);
+    if (y >= trackY) moveRelative(y - trackY, LF, 0x42);
+    else moveRelative(trackY - y, VT, 0x41);
+  }
+  releaseFlush();
 }
 /*--------------------------------------------------------------------*/
 
 void Minitel::moveCursorLeft(int n) {  // Voir p.94 et 95
+  COMPTER_APPEL(STATS_APPEL_CURSEUR);
   if (n==1) { writeByte(BS); }
   else if (n>1) {
     // Curseur vers la gauche de n colonnes. Arrêt au bord gauche de l'écran.
@@ -236,6 +1143,7 @@ void Minitel::moveCursorLeft(int n) {  // Voir p.94 et 95
 /*--------------------------------------------------------------------*/
 
 void Minitel::moveCursorRight(int n) {  // Voir p.94
+  COMPTER_APPEL(STATS_APPEL_CURSEUR);
   if (n==1) { writeByte(HT); }
   else if (n>1) {
     // Curseur vers la droite de n colonnes. Arrêt au bord droit de l'écran.
@@ -247,6 +1155,7 @@ void Minitel::moveCursorRight(int n) {  // Voir p.94
 /*--------------------------------------------------------------------*/
 
 void Minitel::moveCursorDown(int n) {  // Voir p.94
+  COMPTER_APPEL(STATS_APPEL_CURSEUR);
   if (n==1) { writeByte(LF); }
   else if (n>1) {
     // Curseur vers le bas de n rangées. Arrêt en bas de l'écran.
@@ -258,6 +1167,7 @@ void Minitel::moveCursorDown(int n) {  // Voir p.94
 /*--------------------------------------------------------------------*/
 
 void Minitel::moveCursorUp(int n) {  // Voir p.94
+  COMPTER_APPEL(STATS_APPEL_CURSEUR);
   if (n==1) { writeByte(VT); }
   else if (n>1) {
     // Curseur vers le haut de n rangées. Arrêt en haut de l'écran.
@@ -269,27 +1179,46 @@ void Minitel::moveCursorUp(int n) {  // Voir p.94
 /*--------------------------------------------------------------------*/
 
 void Minitel::moveCursorReturn(int n) {  // Voir p.94
+  COMPTER_APPEL(STATS_APPEL_CURSEUR);
   writeByte(CR);
   moveCursorDown(n);  // Pour davantage de souplesse
 }
 /*--------------------------------------------------------------------*/
 
+void Minitel::invalidateCursor() {
+  trackKnown = false;
+  // La rangée a pu changer : les attributs de zone sont perdus eux aussi.
+  trackAttr[ATTR_FOND] = trackAttr[ATTR_MASQUAGE] = trackAttr[ATTR_LIGNAGE] = 0;
+  trackZone[0] = trackZone[1] = trackZone[2] = 0;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::invalidateAttributes() {
+  for (int i=0; i<8; i++) trackAttr[i] = 0;
+  trackZone[0] = trackZone[1] = trackZone[2] = 0;
+}
+/*--------------------------------------------------------------------*/
+
 int Minitel::getCursorX() {
-  return (getCursorXY() & 0x0000FF) - 0x40;
+  unsigned long trame = getCursorXY();
+  return (trame != 0) ? (int) (trame & 0x0000FF) - 0x40 : -1;
 }
 /*--------------------------------------------------------------------*/
 
 int Minitel::getCursorY() {
-  return ((getCursorXY() & 0x00FF00) >> 8) - 0x40;
+  unsigned long trame = getCursorXY();
+  return (trame != 0) ? (int) ((trame & 0x00FF00) >> 8) - 0x40 : -1;
 }
 /*--------------------------------------------------------------------*/
 
 void Minitel::cancel() {  // Voir p.95
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeByte(CAN);
 }
 /*--------------------------------------------------------------------*/
 
 void Minitel::clearScreenFromCursor() {  // Voir p.95
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeWord(CSI);  // 0x1B 0x5B
   // writeByte(0x30);  Inutile
   writeByte(0x4A);
@@ -297,6 +1226,7 @@ void Minitel::clearScreenFromCursor() {  // Voir p.95
 /*--------------------------------------------------------------------*/
 
 void Minitel::clearScreenToCursor() {  // Voir p.95
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeWord(CSI);  // 0x1B 0x5B
   writeByte(0x31);
   writeByte(0x4A);
@@ -304,6 +1234,7 @@ void Minitel::clearScreenToCursor() {  // Voir p.95
 /*--------------------------------------------------------------------*/
 
 void Minitel::clearScreen() {  // Voir p.95
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeWord(CSI);  // 0x1B 0x5B
   writeByte(0x32);
   writeByte(0x4A);
@@ -311,6 +1242,7 @@ void Minitel::clearScreen() {  // Voir p.95
 /*--------------------------------------------------------------------*/
 
 void Minitel::clearLineFromCursor() {  // Voir p.95
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeWord(CSI);  // 0x1B 0x5B
   // writeByte(0x30);  Inutile
   writeByte(0x4B);
@@ -318,6 +1250,7 @@ void Minitel::clearLineFromCursor() {  // Voir p.95
 /*--------------------------------------------------------------------*/
 
 void Minitel::clearLineToCursor() {  // Voir p.95
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeWord(CSI);  // 0x1B 0x5B
   writeByte(0x31);
   writeByte(0x4B);
@@ -325,6 +1258,7 @@ void Minitel::clearLineToCursor() {  // Voir p.95
 /*--------------------------------------------------------------------*/
 
 void Minitel::clearLine() {  // Voir p.95
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeWord(CSI);  // 0x1B 0x5B
   writeByte(0x32);
   writeByte(0x4B);
@@ -332,6 +1266,7 @@ void Minitel::clearLine() {  // Voir p.95
 /*--------------------------------------------------------------------*/
 
 void Minitel::deleteChars(int n) {  // Voir p.95
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeWord(CSI);  // 0x1B 0x5B
   writeBytesP(n);  // Voir section Private ci-dessous
   writeByte(0x50);
@@ -339,6 +1274,7 @@ void Minitel::deleteChars(int n) {  // Voir p.95
 /*--------------------------------------------------------------------*/
 
 void Minitel::insertChars(int n) {  // Voir p.95
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeWord(CSI);  // 0x1B 0x5B
   writeBytesP(n);  // Voir section Private ci-dessous
   writeByte(0x40);
@@ -346,6 +1282,7 @@ void Minitel::insertChars(int n) {  // Voir p.95
 /*--------------------------------------------------------------------*/
 
 void Minitel::startInsert() {  // Voir p.95
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeWord(CSI);  // 0x1B 0x5B
   writeByte(0x34);
   writeByte(0x68);
@@ -353,6 +1290,7 @@ void Minitel::startInsert() {  // Voir p.95
 /*--------------------------------------------------------------------*/
 
 void Minitel::stopInsert() {  // Voir p.95
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeWord(CSI);  // 0x1B 0x5B
   writeByte(0x34);
   writeByte(0x6C);
@@ -360,6 +1298,7 @@ void Minitel::stopInsert() {  // Voir p.95
 /*--------------------------------------------------------------------*/
 
 void Minitel::deleteLines(int n) {  // Voir p.95
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeWord(CSI);  // 0x1B 0x5B
   writeBytesP(n);  // Voir section Private ci-dessous
   writeByte(0x4D);
@@ -367,6 +1306,7 @@ void Minitel::deleteLines(int n) {  // Voir p.95
 /*--------------------------------------------------------------------*/
 
 void Minitel::insertLines(int n) {  // Voir p.95
+  COMPTER_APPEL(STATS_APPEL_EFFACEMENTS);
   writeWord(CSI);  // 0x1B 0x5B
   writeBytesP(n);  // Voir section Private ci-dessous
   writeByte(0x4C);
@@ -374,90 +1314,141 @@ void Minitel::insertLines(int n) {  // Voir p.95
 /*--------------------------------------------------------------------*/
 
 void Minitel::textMode() {
-  writeByte(SI);  // Accès au jeu G0 (voir p.100)
+  COMPTER_APPEL(STATS_APPEL_ATTRIBUTS);
+  if (trackAttr[ATTR_JEU] != SI) writeByte(SI);  // Accès au jeu G0 (voir p.100)
 }
 /*--------------------------------------------------------------------*/
 
 void Minitel::graphicMode() {
-  writeByte(SO);  // Accès au jeu G1 (voir p.101 & 102)
+  COMPTER_APPEL(STATS_APPEL_ATTRIBUTS);
+  if (trackAttr[ATTR_JEU] != SO) writeByte(SO);  // Accès au jeu G1 (voir p.101 & 102)
 }
 /*--------------------------------------------------------------------*/
 
 byte Minitel::pageMode() {
+  return (byte) waitReply(pageModeAsync(NULL));  // 0 sans réponse
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::pageModeAsync(MinitelCallback callback) {
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeBytesPRO(2);    // 0x1B 0x3A
   writeByte(STOP);     // 0x6A
   writeByte(ROULEAU);  // 0x43
+  trackScroll = false;
   // Acquittement
-  return workingMode();  // Renvoie un octet
+  return request(i, REQUETE_FONCTIONNEMENT, 0, callback);
 }
 /*--------------------------------------------------------------------*/
 
 byte Minitel::scrollMode() {
+  return (byte) waitReply(scrollModeAsync(NULL));  // 0 sans réponse
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::scrollModeAsync(MinitelCallback callback) {
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeBytesPRO(2);    // 0x1B 0x3A
   writeByte(START);    // 0x69
   writeByte(ROULEAU);  // 0x43
+  trackScroll = true;
   // Acquittement
-  return workingMode();  // Renvoie un octet
+  return request(i, REQUETE_FONCTIONNEMENT, 0, callback);
+}
+/*--------------------------------------------------------------------*/
+
+byte Minitel::modeMixte() {
+  return (byte) waitReply(modeMixteAsync(NULL));  // 0 sans réponse
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::modeMixte() {  // Voir p.144
+int Minitel::modeMixteAsync(MinitelCallback callback) {  // Voir p.144
   // Passage du standard Télétel mode Vidéotex au standard Télétel mode Mixte
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeBytesPRO(2);   // 0x1B 0x3A
   writeWord(MIXTE1);  // 0x32 0x7D
+  trackColumns = 80;
+  trackKnown = false;
   // Acquittement
-  return workingStandard(0x1370);  // SEP (0x13), 0x70
+  return request(i, REQUETE_STANDARD, 0x1370, callback);
+}
+/*--------------------------------------------------------------------*/
+
+byte Minitel::modeVideotex() {
+  return (byte) waitReply(modeVideotexAsync(NULL));  // 0 sans réponse
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::modeVideotex() {  // Voir p.144
+int Minitel::modeVideotexAsync(MinitelCallback callback) {  // Voir p.144
   // Passage du standard Télétel mode Mixte au standard Télétel mode Vidéotex
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeBytesPRO(2);   // 0x1B 0x3A
   writeWord(MIXTE2);  // 0x32 0x7E
+  trackColumns = 40;
+  trackKnown = false;
   // Acquittement
-  return workingStandard(0x1371);  // SEP (0x13), 0x71
+  return request(i, REQUETE_STANDARD, 0x1371, callback);
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::standardTeleinformatique() {  // Voir p.144
+byte Minitel::standardTeleinformatique() {
+  return (byte) waitReply(standardTeleinformatiqueAsync(NULL));  // 0 sans réponse
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::standardTeleinformatiqueAsync(MinitelCallback callback) {  // Voir p.144
   // Passage du standard Télétel au standard Téléinformatique
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeBytesPRO(2);    // 0x1B 0x3A
   writeWord(TELINFO);  // 0x31 0x7D
   // Acquittement
-  return workingStandard(0x1B5B3F7A);  // CSI (0x1B,0x5B), 0x3F, 0x7A
+  return request(i, REQUETE_STANDARD, 0x1B5B3F7A, callback);
+}
+/*--------------------------------------------------------------------*/
+
+byte Minitel::standardTeletel() {
+  return (byte) waitReply(standardTeletelAsync(NULL));  // 0 sans réponse
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::standardTeletel() {  // Voir p.144
+int Minitel::standardTeletelAsync(MinitelCallback callback) {  // Voir p.144
   // Passage du standard Téléinformatique au standard Télétel
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeWord(CSI);  // 0x1B Ox5B
   writeByte(0x3F);
   writeByte(0x7B);
   // Acquittement
-  return workingStandard(0x135E);  // SEP (0x13), 0x5E
+  return request(i, REQUETE_STANDARD, 0x135E, callback);
 }
 /*--------------------------------------------------------------------*/
 
 void Minitel::attributs(byte attribut) {
-  writeByte(ESC);  // Accès à la grille C1 (voir p.92)
-  writeByte(attribut);
+  COMPTER_APPEL(STATS_APPEL_ATTRIBUTS);
+  int i = attrIndex(attribut);
+  if (i < 0 || trackAttr[i] != attribut) {  // Sinon l'attribut est déjà en vigueur
+    writeByte(ESC);  // Accès à la grille C1 (voir p.92)
+    writeByte(attribut);
+  }
   if (attribut == DOUBLE_HAUTEUR || attribut == DOUBLE_GRANDEUR) {
     moveCursorDown(1);
-    currentSize = attribut;
-  }
-  else if (attribut == GRANDEUR_NORMALE || attribut == DOUBLE_LARGEUR) {
-    currentSize = attribut;
   }
 }
 /*--------------------------------------------------------------------*/
 
-void Minitel::print(String chaine) {
+void Minitel::print(const String& chaine) {
+  COMPTER_APPEL(STATS_APPEL_TEXTE);
   // Fonction modifiée par iodeo sur GitHub en février 2023
 /*
   // Fonction initiale (pour mémoire)  // Obsolète depuis le 26/02/2023
@@ -474,97 +1465,104 @@ void Minitel::print(String chaine) {
   }
 */
   // codes UTF-8 vers codes Minitel
-  unsigned int i = 0;
-  while (i < chaine.length()) {
-    unsigned long code = (byte) chaine.charAt(i++);
-    if (code < SP) code = 0;
-    else if (code >= SP && code <= DEL) {
-      switch (code) {
-        case 0x5E: code = 0; break; // ^ non visualisable seul
-        case 0x60: code = 0; break; // ` non visualisable seul
-      }
-    }
-    else if (code == 0xC2 || code == 0xC3 || code == 0xC5 || code == 0xCE) {
-      // Caractères sur 2 octets
-      code = (code << 8) + (byte) chaine.charAt(i++);
-      switch (code) {                        // Voir p.90 pour VGP5 ou VGP2
-                         // 0x19 => SS2 (Accès au jeu G2)
-                         // 0x0F => SI (Accès au jeu G0)
-        case 0xC2A3: code = 0x1923; break;   // £ (VGP5 et VGP2)
-        case 0xC2A7: code = 0x1927; break;   // § (VGP5 seulement)
-        case 0xC2B0: code = 0x1930; break;   // ° (VGP5 et VGP2)
-        case 0xC2B1: code = 0x1931; break;   // ± (VGP5 et VGP2)
-        case 0xC2BC: code = 0x193C; break;   // ¼ (VGP5 et VGP2)
-        case 0xC2BD: code = 0x193D; break;   // ½ (VGP5 et VGP2)
-        case 0xC2BE: code = 0x193E; break;   // ¾ (VGP5 et VGP2)
-        case 0xC380: code = 0x0F41; break;   // À (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC382: code = 0x0F41; break;   // Â (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC384: code = 0x0F41; break;   // Ä (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC387: code = 0x0F43; break;   // Ç (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC388: code = 0x0F45; break;   // È (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC389: code = 0x0F45; break;   // É (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC38A: code = 0x0F45; break;   // Ê (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC38B: code = 0x0F45; break;   // Ë (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC38E: code = 0x0F49; break;   // Î (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC38F: code = 0x0F49; break;   // Ï (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC394: code = 0x0F4F; break;   // Ô (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC396: code = 0x0F4F; break;   // Ö (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC399: code = 0x0F55; break;   // Ù (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC39B: code = 0x0F55; break;   // Û (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC39C: code = 0x0F55; break;   // Ü (Aucune lettre accentuée majuscule n'est disponible - voir p.90)
-        case 0xC3A0: code = 0x194161; break; // à (VGP5 et VGP2)
-        case 0xC3A2: code = 0x194361; break; // â (VGP5 et VGP2)
-        case 0xC3A4: code = 0x194861; break; // ä (VGP5 seulement)
-        case 0xC3A7: code = 0x194B63; break; // ç (VGP5 et VGP2)
-        case 0xC3A8: code = 0x194165; break; // è (VGP5 et VGP2)
-        case 0xC3A9: code = 0x194265; break; // é (VGP5 et VGP2)
-        case 0xC3AA: code = 0x194365; break; // ê (VGP5 et VGP2)
-        case 0xC3AB: code = 0x194865; break; // ë (VGP5 et VGP2)
-        case 0xC3AE: code = 0x194369; break; // î (VGP5 et VGP2)
-        case 0xC3AF: code = 0x194869; break; // ï (VGP5 et VGP2)
-        case 0xC3B4: code = 0x19436F; break; // ô (VGP5 et VGP2)
-        case 0xC3B6: code = 0x19486F; break; // ö (VGP5 seulement)
-        case 0xC3B7: code = 0x1938; break;   // ÷ (VGP5 et VGP2)
-        case 0xC3B9: code = 0x194175; break; // ù (VGP5 et VGP2)
-        case 0xC3BB: code = 0x194375; break; // û (VGP5 et VGP2)
-        case 0xC3BC: code = 0x194875; break; // ü (VGP5 seulement)
-        case 0xC592: code = 0x196A; break;   // Œ (VGP5 et VGP2)
-        case 0xC593: code = 0x197A; break;   // œ (VGP5 et VGP2)
-        case 0xCEB2: code = 0x197B; break;   // β (VGP5 seulement)
-        default: code = 0; // supposé non-visualisable
-      }
-    }
-    else if (code == 0xE2) {
-      // Caractères sur 3 octets
-      code = (code << 8) + (byte) chaine.charAt(i++);
-      code = (code << 8) + (byte) chaine.charAt(i++);
-      switch (code) {
-        case 0xE28094: code = 0x60; break;   // —
-        case 0xE28690: code = 0x192C; break; // ←
-        case 0xE28691: code = 0x5E; break;   // ↑
-        case 0xE28692: code = 0x192E; break; // →
-        case 0xE28693: code = 0x192F; break; // ↓
-        default: code = 0; // supposé non-visualisable
-      }
-    }
-    if (code != 0) writeCode(code);
-  }
+  print(chaine.c_str(), chaine.length());
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::print(const char* chaine) {
+  COMPTER_APPEL(STATS_APPEL_TEXTE);
+  if (chaine == NULL) return;  // Comme String(NULL) : chaîne vide
+  print(chaine, strlen(chaine));
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::print(const char* chaine, size_t size) {
+  COMPTER_APPEL(STATS_APPEL_TEXTE);
+  if (chaine == NULL) return;
+  MinitelTranscoder utf8;
+  holdFlush();  // La chaîne est envoyée d'un bloc
+  printUtf8(utf8, (const byte*) chaine, size);
+  releaseFlush();
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::print(const __FlashStringHelper* chaine) {
+  COMPTER_APPEL(STATS_APPEL_TEXTE);
+  // La chaîne est recopiée de la mémoire flash par petits blocs, une
+  // séquence UTF-8 coupée entre deux blocs étant reconstituée.
+  const char* p = (const char*) chaine;
+  if (p == NULL) return;
+  MinitelTranscoder utf8;
+  byte bloc[16];
+  size_t n;
+  holdFlush();
+  do {
+    n = 0;
+    byte b;
+    while (n < sizeof(bloc) && (b = pgm_read_byte(p++)) != 0) bloc[n++] = b;
+    printUtf8(utf8, bloc, n);
+  } while (n == sizeof(bloc));
+  releaseFlush();
+}
+/*--------------------------------------------------------------------*/
+
+#if !defined(ARDUINO) && __cplusplus >= 201703L
+void Minitel::print(std::string_view chaine) {
+  COMPTER_APPEL(STATS_APPEL_TEXTE);
+  print(chaine.data(), chaine.size());
+}
+/*--------------------------------------------------------------------*/
+#endif
+/*--------------------------------------------------------------------*/
+
+unsigned long Minitel::getVideotexCode(const String& chaine, unsigned int& i) {
+  // Fonction extraite de print(String chaine)
+  // Lit le caractère UTF-8 qui commence à la position i de chaine,
+  // avance i jusqu'au caractère suivant et renvoie la séquence Minitel
+  // correspondante (à envoyer avec writeCode), ou 0 si le caractère
+  // n'est pas visualisable. Un caractère tronqué en fin de chaîne est ignoré.
+  MinitelTranscoder utf8;
+  byte codes[MinitelTranscoder::MAX_CODE];
+  size_t n = 0;
+  do {
+    n = utf8.transcode((const byte*) chaine.c_str() + i++, 1, codes, sizeof(codes));
+  } while (utf8.inSequence() && i < chaine.length());
+  unsigned long code = 0;
+  for (size_t k=0; k<n; k++) code = (code << 8) + codes[k];
+  return code;
 }
 /*--------------------------------------------------------------------*/
 
-void Minitel::println(String chaine) {
+void Minitel::println(const String& chaine) {
+  COMPTER_APPEL(STATS_APPEL_TEXTE);
+  holdFlush();
   print(chaine);
-  if (currentSize == DOUBLE_HAUTEUR || currentSize == DOUBLE_GRANDEUR) {
-    moveCursorReturn(2);
-  }
-  else {
-    moveCursorReturn(1);
-  }
+  println();
+  releaseFlush();
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::println(const char* chaine) {
+  COMPTER_APPEL(STATS_APPEL_TEXTE);
+  holdFlush();
+  if (chaine != NULL) print(chaine);  // NULL : retour à la ligne seul, comme avec String(NULL)
+  println();
+  releaseFlush();
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::println(const __FlashStringHelper* chaine) {
+  COMPTER_APPEL(STATS_APPEL_TEXTE);
+  holdFlush();
+  if (chaine != NULL) print(chaine);
+  println();
+  releaseFlush();
 }
 /*--------------------------------------------------------------------*/
 
 void Minitel::println() {
-  if (currentSize == DOUBLE_HAUTEUR || currentSize == DOUBLE_GRANDEUR) {
+  COMPTER_APPEL(STATS_APPEL_TEXTE);
+  if (trackAttr[ATTR_TAILLE] == DOUBLE_HAUTEUR || trackAttr[ATTR_TAILLE] == DOUBLE_GRANDEUR) {
     moveCursorReturn(2);
   }
   else {
@@ -574,6 +1572,7 @@ void Minitel::println() {
 /*--------------------------------------------------------------------*/
 
 void Minitel::printChar(char caractere) {
+  COMPTER_APPEL(STATS_APPEL_TEXTE);
   // Peut s'utiliser de 2 manières : printChar('A') ou printChar(0x41) par exemple
   //                                 printChar("A") ne fonctionne pas
   byte charByte = getCharByte(caractere);
@@ -582,6 +1581,18 @@ void Minitel::printChar(char caractere) {
   }
 }
 /*--------------------------------------------------------------------*/
+
+void Minitel::printChars(const char* caracteres, size_t size) {
+  COMPTER_APPEL(STATS_APPEL_TEXTE);
+  // Comme printChar pour chaque caractère, en un seul bloc
+  holdFlush();
+  for (size_t i=0; i<size; i++) {
+    byte charByte = getCharByte(caracteres[i]);
+    if (isValidChar(charByte)) writeByte(charByte);
+  }
+  releaseFlush();
+}
+/*--------------------------------------------------------------------*/
 /*
 void Minitel::printDiacriticChar(unsigned char caractere) {  // Obsolète depuis le 26/02/2023
   writeByte(SS2);  // Accès au jeu G2 (voir p.103)
@@ -630,6 +1641,7 @@ void Minitel::printDiacriticChar(unsigned char caractere) {  // Obsolète depuis
 /*--------------------------------------------------------------------*/
 
 void Minitel::printSpecialChar(byte b) {
+  COMPTER_APPEL(STATS_APPEL_TEXTE);
   // N'est pas fonctionnelle pour les diacritiques (accents, tréma et cédille)
   writeByte(SS2);  // Accès au jeu G2 (voir p.103)
   writeByte(b);
@@ -638,11 +1650,10 @@ void Minitel::printSpecialChar(byte b) {
 
 byte Minitel::getCharByte(char caractere) {
   // Voir les codes et séquences émis en mode Vidéotex (Jeu G0 p.100).
-  // Dans la chaine ci-dessous, on utilise l'échappement (\) :
-  // \" rend au guillemet sa signification littérale.
-  // \\ donne à l'antislash sa signification littérale .
-  String caracteres = "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_xabcdefghijklmnopqrstuvwxyz{|}";
-  return (byte) caracteres.lastIndexOf(caractere);
+  // Le code est celui du caractère ASCII, sauf pour 0x60, 0x7E et 0x7F
+  // qui n'ont pas le même dessin sur le Minitel (0xFF : pas de code).
+  byte b = (byte) caractere;
+  return (b >= SP && b <= 0x7D && b != 0x60) ? b : 0xFF;
 }
 /*--------------------------------------------------------------------*/
 
@@ -656,9 +1667,9 @@ String Minitel::getString(unsigned long code) {
   Serial.print("isVisual ");
   Serial.print(code);
   Serial.print("\t : ");
-  Serial.println(isVisualisable(code));
+  Serial.println(MinitelTranscoder::isVisualisable(code));
   */
-  if (isVisualisable(code)) {
+  if (MinitelTranscoder::isVisualisable(code)) {
     if (code < 0x80) { // U+0000 à U+007F
       str += char(code);
     } else if (code < 0x800) { // U+0080 à U+07FF
@@ -678,7 +1689,7 @@ int Minitel::getNbBytes(unsigned long code) {
   // Cette fonction est à utiliser en association avec getString(unsigned long code) juste ci-dessus
   // Elle renvoie le nombre d'octets d'un caractère codé en String UTF-8
   int nbBytes = 0;
-  if (isVisualisable(code)) {
+  if (MinitelTranscoder::isVisualisable(code)) {
     if (code < 0x80) { // U+0000 à U+007F
       nbBytes = 1;  // 1 octet
     } else if (code < 0x800) { // U+0080 à U+07FF
@@ -693,30 +1704,29 @@ int Minitel::getNbBytes(unsigned long code) {
 /*--------------------------------------------------------------------*/
 
 void Minitel::graphic(byte b, int x, int y) {
+  COMPTER_APPEL(STATS_APPEL_GRAPHIC);
   moveCursorXY(x,y);
   graphic(b);
 }
 /*--------------------------------------------------------------------*/
 
 void Minitel::graphic(byte b) {
+  COMPTER_APPEL(STATS_APPEL_GRAPHIC);
   // Voir Jeu G1 page 101.
   if (b <= 0b111111) {
-    b = 0x20
-      + bitRead(b,5) 
-      + bitRead(b,4) * 2
-      + bitRead(b,3) * 4
-      + bitRead(b,2) * 8
-      + bitRead(b,1) * 16
-      + bitRead(b,0) * 64;
-    if (b == 0x7F) {  // 0b1111111
-      b= 0x5F;
-    }    
-  writeByte(b);
+    writeByte(getGraphicByte(b));
   }
 }
 /*--------------------------------------------------------------------*/
 
+byte Minitel::getGraphicByte(byte b) {
+  // Voir Jeu G1 page 101.
+  return pgm_read_byte(MOSAIQUES + (b & 0b111111));
+}
+/*--------------------------------------------------------------------*/
+
 void Minitel::repeat(int n) {  // Voir p.98
+  COMPTER_APPEL(STATS_APPEL_GRAPHIC);
   writeByte(REP);
   writeByte(0x40 + n);
 }
@@ -728,30 +1738,77 @@ void Minitel::bip() {  // Voir p.98
 /*--------------------------------------------------------------------*/
 
 void Minitel::rect(int x1, int y1, int x2, int y2) {
-  hLine(x1,y1,x2,BOTTOM);
-  vLine(x2,y1+1,y2,RIGHT,DOWN);
-  hLine(x1,y2,x2,TOP);
-  vLine(x1,y1,y2-1,LEFT,UP);
+  COMPTER_APPEL(STATS_APPEL_GEOMETRIE);
+  holdFlush();
+  frame(x1, y1, x2, y2, false, NULL);
+  moveCursorXY(x1,y1);  // Comme avant : le curseur finit dans le coin supérieur gauche.
+  releaseFlush();
 }
 /*--------------------------------------------------------------------*/
 
-void Minitel::hLine(int x1, int y, int x2, int position) {
-  textMode();
-  moveCursorXY(x1,y);
-  switch (position) {
-    case TOP    : writeByte(0x7E); break;
-    case CENTER : writeByte(0x60); break;
-    case BOTTOM : writeByte(0x5F); break;
-  }
-  repeat(x2-x1);
+void Minitel::panel(int x1, int y1, int x2, int y2, const char* titre) {
+  COMPTER_APPEL(STATS_APPEL_GEOMETRIE);
+  frame(x1, y1, x2, y2, true, titre);
 }
 /*--------------------------------------------------------------------*/
 
-void Minitel::vLine(int x, int y1, int y2, int position, int sens) {
-  textMode();
-  switch (sens) {
-    case DOWN : moveCursorXY(x,y1); break;
-    case UP   : moveCursorXY(x,y2); break;
+void Minitel::fillRect(int x1, int y1, int x2, int y2) {
+  COMPTER_APPEL(STATS_APPEL_GEOMETRIE);
+  holdFlush();
+  byte fond = trackAttr[ATTR_FOND];  // Perdu par le tracé aux changements de rangée
+  for (int y=y1; y<=y2; y++) {
+    moveCursorXY(x1,y);
+    if (fond != 0) attributs(fond);
+    if (x2 >= trackColumns && x2 > x1) {
+      writeByte(CAN);  // Jusqu'au bout de la rangée, sans déplacer le curseur
+    }
+    else {
+      for (int x=x1; x<=x2; x++) writeByte(SP);  // Codé par REP
+    }
+  }
+  releaseFlush();
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::clearRect(int x1, int y1, int x2, int y2) {
+  COMPTER_APPEL(STATS_APPEL_GEOMETRIE);
+  holdFlush();
+  for (int y=y1; y<=y2; y++) {
+    if (x2 >= trackColumns) {
+      moveCursorXY(x1,y);
+      clearLineFromCursor();
+    }
+    else {
+      newXY(x1,y);  // Attributs par défaut : les espaces écrits sont des cases vides.
+      for (int x=x1; x<=x2; x++) writeByte(SP);
+    }
+  }
+  releaseFlush();
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::hLine(int x1, int y, int x2, int position) {
+  COMPTER_APPEL(STATS_APPEL_GEOMETRIE);
+  holdFlush();
+  textMode();
+  moveCursorXY(x1,y);
+  byte c = 0x60;  // CENTER
+  switch (position) {
+    case TOP    : c = 0x7E; break;
+    case BOTTOM : c = 0x5F; break;
+  }
+  for (int x=x1; x<=x2; x++) writeByte(c);  // Codé par REP
+  releaseFlush();
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::vLine(int x, int y1, int y2, int position, int sens) {
+  COMPTER_APPEL(STATS_APPEL_GEOMETRIE);
+  holdFlush();
+  textMode();
+  switch (sens) {
+    case DOWN : moveCursorXY(x,y1); break;
+    case UP   : moveCursorXY(x,y2); break;
   }
   for (int i=0; i<y2-y1; i++) {
     switch (position) {
@@ -759,232 +1816,272 @@ void Minitel::vLine(int x, int y1, int y2, int position, int sens) {
       case CENTER : writeByte(0x7C); break;
       case RIGHT  : writeByte(0x7D); break;
     }
-    switch (sens) {
-      case DOWN : moveCursorLeft(1); moveCursorDown(1); break;
-      case UP   : moveCursorLeft(1); moveCursorUp(1); break;
+    int y = (sens == DOWN) ? y1+i+1 : y2-i-1;
+    if (y >= 1 && y <= 24) {
+      moveCursorXY(x,y);  // BS puis LF ou VT
+    }
+    else {  // Au-delà du bord de l'écran : on laisse le Minitel faire le tour
+      moveCursorLeft(1);
+      if (sens == DOWN) moveCursorDown(1); else moveCursorUp(1);
     }
   }
+  releaseFlush();
 }
 /*--------------------------------------------------------------------*/
 
 unsigned long Minitel::getKeyCode(bool unicode) {
   // Renvoie le code brut émis par le clavier (unicode = false)
   // ou sa conversion unicode si applicable (unicode = true, choix par défaut)
-  unsigned long code = 0;
-  // Code unique
-  if (available()>0) {
-    code = readByte();
-  }
-  // Séquences de deux ou trois codes (voir p.118)
-  if (code == 0x19) {  // SS2
-    while (!available()>0);  // Indispensable
-    code = (code << 8) + readByte();
-    // Les diacritiques (3 codes)
-    if ((code == 0x1941) || (code == 0x1942) || (code == 0x1943) || (code == 0x1948) || (code == 0x194B)) {  // Accents, tréma, cédille
-      // Bug 1 : Pour éviter de compter un caractère lorsqu'on appuie plusieurs fois de suite sur une touche avec accent ou tréma
-      byte caractere = 0x19;
-      while (caractere == 0x19) {  
-        while (!available()>0);  // Indispensable
-        caractere = readByte();
-        if (caractere == 0x19) {
-          while (!available()>0);  // Indispensable
-          caractere = readByte();
-          caractere = 0x19;
-        }
-      }
-      // Bug 2 : Pour éviter de compter un caractère lorsqu'on appuie sur les touches de fonction après avoir appuyé sur une touche avec accent ou tréma
-      if (caractere == 0x13) {  // Les touches RETOUR REPETITION GUIDE ANNULATION SOMMAIRE CORRECTION SUITE CONNEXION_FIN ont un code qui commence par 0x13
-          while (!available()>0);  // Indispensable
-          caractere = readByte();  // Les touches de fonction sont codées sur 2 octets (0x13..)
-          caractere = 0;
-          code = 0;
-      }
-      code = (code << 8) + caractere;
-      if (unicode) {
-        switch (code) {  // On convertit le code reçu en unicode
-          case 0x194161 : code = 0xE0; break;  // à
-          case 0x194165 : code = 0xE8; break;  // è
-          case 0x194175 : code = 0xF9; break;  // ù
-          case 0x194265 : code = 0xE9; break;  // é
-          case 0x194361 : code = 0xE2; break;  // â
-          case 0x194365 : code = 0xEA; break;  // ê
-          case 0x194369 : code = 0xEE; break;  // î
-          case 0x19436F : code = 0xF4; break;  // ô
-          case 0x194375 : code = 0xFB; break;  // û
-          case 0x194861 : code = 0xE4; break;  // ä
-          case 0x194865 : code = 0xEB; break;  // ë
-          case 0x194869 : code = 0xEF; break;  // ï
-          case 0x19486F : code = 0xF6; break;  // ö
-          case 0x194875 : code = 0xFC; break;  // ü
-          case 0x194B63 : code = 0xE7; break;  // ç
-          default : code = caractere; break;
-        }
-      }
-    }
-    // Les autres caractères spéciaux disponibles sous Arduino (2 codes)
-    else {
-      if (unicode) {
-        switch (code) {  // On convertit le code reçu en unicode
-          case 0x1923 : code = 0xA3; break;    // Livre
-          case 0x1927 : code = 0xA7; break;    // Paragraphe
-          case 0x192C : code = 0x2190; break;  // Flèche gauche
-          case 0x192E : code = 0x2192; break;  // Flèche droite
-          case 0x192F : code = 0x2193; break;  // Flèche bas
-          case 0x1930 : code = 0xB0; break;    // Degré
-          case 0x1931 : code = 0xB1; break;    // Plus ou moins
-          case 0x1938 : code = 0xF7; break;    // Division
-          case 0x196A : code = 0x0152; break;  // Ligature OE
-          case 0x197A : code = 0x0153; break;  // Ligature oe
-          case 0x197B : code = 0x03B2; break;  // Bêta
-        }
-      }
-    }
-  }
-  // Touches de fonction (voir p.123)
-  else if (code == 0x13) {
-    while (!available()>0);  // Indispensable
-    code = (code << 8) + readByte();
-  }  
-  // Touches de gestion du curseur lorsque le clavier est en mode étendu (voir p.124)
-  // Pour passer au clavier étendu manuellement : Fnct C + E
-  // Pour revenir au clavier vidéotex standard  : Fnct C + V
-  else if (code == 0x1B) {
-    delay(20);  // Indispensable. 0x1B seul correspond à la touche Esc,
-                // on ne peut donc pas utiliser la boucle while (!available()>0).           
-    if (available()>0) {
-      code = (code << 8) + readByte();
-      if (code == 0x1B5B) {
-        while (!available()>0);  // Indispensable
-        code = (code << 8) + readByte();
-        if ((code == 0x1B5B34) || (code == 0x1B5B32)) {
-          while (!available()>0);  // Indispensable
-          code = (code << 8) + readByte();
-        }
-      }
-    }
-  }
-  else {
-    if (unicode) {  // On convertit les codes uniques en unicode
-      switch (code) {
-        case 0x5E : code = 0x2191; break;  // Flèche haut
-        case 0x60 : code = 0x2014; break;  // Tiret cadratin
-      }
-    }
-  }
-// Pour test
-/*
-  if (code != 0) {
-    Serial.print(code,HEX);
-    Serial.print(" ");
-    Serial.write(code);
-    Serial.println("");
-  }
-*/
-  return code;
+  flush();  // Ce qui a été écrit doit être à l'écran avant de lire le clavier
+  MinitelKeyEvent touche;
+  if (!readKey(touche)) return 0;
+  return unicode ? touche.unicode : touche.code;
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::keyAvailable() {
+  poll();
+  return keyCount;
+}
+/*--------------------------------------------------------------------*/
+
+boolean Minitel::readKey(MinitelKeyEvent& touche) {
+  if (keyAvailable() == 0) return false;
+  touche = keyEvents[keyStart];
+  keyStart = (keyStart + 1) % MINITEL_KEY_EVENTS;
+  keyCount--;
+  return true;
 }
 /*--------------------------------------------------------------------*/
 
 byte Minitel::smallMode() {
+  return (byte) waitReply(smallModeAsync(NULL));  // 0 sans réponse
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::smallModeAsync(MinitelCallback callback) {
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeBytesPRO(2);       // 0x1B 0x3A
   writeByte(START);       // 0x69
   writeByte(MINUSCULES);  // 0x45
   // Acquittement
-  return workingMode();   // Renvoie un octet
+  return request(i, REQUETE_FONCTIONNEMENT, 0, callback);
 }
 /*--------------------------------------------------------------------*/
 
 byte Minitel::capitalMode() {
+  return (byte) waitReply(capitalModeAsync(NULL));  // 0 sans réponse
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::capitalModeAsync(MinitelCallback callback) {
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeBytesPRO(2);       // 0x1B 0x3A
   writeByte(STOP);        // 0x6A
   writeByte(MINUSCULES);  // 0x45
   // Acquittement
-  return workingMode();   // Renvoie un octet
+  return request(i, REQUETE_FONCTIONNEMENT, 0, callback);
 }
 /*--------------------------------------------------------------------*/
 
 byte Minitel::extendedKeyboard() {
+  return (byte) waitReply(extendedKeyboardAsync(NULL));  // 0 sans réponse
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::extendedKeyboardAsync(MinitelCallback callback) {
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeBytesPRO(3);                   // 0x1B 0x3B
   writeByte(START);                   // 0x69
   writeByte(CODE_RECEPTION_CLAVIER);  // 0x59
   writeByte(ETEN);                    // 0x41
   // Acquittement
-  return workingKeyboard();  // Renvoie un octet
+  return request(i, REQUETE_CLAVIER, 0, callback);
 }
 /*--------------------------------------------------------------------*/
 
 byte Minitel::standardKeyboard() {
+  return (byte) waitReply(standardKeyboardAsync(NULL));  // 0 sans réponse
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::standardKeyboardAsync(MinitelCallback callback) {
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeBytesPRO(3);                   // 0x1B 0x3B
   writeByte(STOP);                    // 0x6A
   writeByte(CODE_RECEPTION_CLAVIER);  // 0x59
   writeByte(ETEN);                    // 0x41
   // Acquittement
-  return workingKeyboard();  // Renvoie un octet
+  return request(i, REQUETE_CLAVIER, 0, callback);
+}
+/*--------------------------------------------------------------------*/
+
+byte Minitel::echo(boolean commande) {
+  return (byte) waitReply(echoAsync(commande, NULL));  // 0 sans réponse
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::echo(boolean commande) {  // Voir p.81, p.135 et p.156
+int Minitel::echoAsync(boolean commande, MinitelCallback callback) {  // Voir p.81, p.135 et p.156
   // Fonction modifiée par iodeo sur GitHub en octobre 2021
   // commande peut prendre comme valeur :
   // true, false
-  return aiguillage(commande, CODE_EMISSION_CLAVIER, CODE_RECEPTION_MODEM);
+  int requete = aiguillageAsync(commande, CODE_EMISSION_CLAVIER, CODE_RECEPTION_MODEM, callback);
+  if (requete >= 0) trackEcho = commande;  // Commande envoyée
+  return requete;
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::aiguillage(boolean commande, byte emetteur, byte recepteur) {  // Voir p.135
+byte Minitel::aiguillage(boolean commande, byte emetteur, byte recepteur) {
+  return (byte) waitReply(aiguillageAsync(commande, emetteur, recepteur, NULL));  // 0 sans réponse
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::aiguillageAsync(boolean commande, byte emetteur, byte recepteur, MinitelCallback callback) {  // Voir p.135
   // commande peut prendre comme valeur :
   // true, false
   // emetteur peut prendre comme valeur :
   // CODE_EMISSION_ECRAN, CODE_EMISSION_CLAVIER, CODE_EMISSION_MODEM, CODE_EMISSION_PRISE
   // recepteur peut prendre comme valeur :
   // CODE_RECEPTION_ECRAN, CODE_RECEPTION_CLAVIER, CODE_RECEPTION_MODEM, CODE_RECEPTION_PRISE
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeBytesPRO(3);                                     // 0x1B 0x3B
   writeByte(commande ? AIGUILLAGE_ON : AIGUILLAGE_OFF); // 0x61 ou 0x60
   writeByte(recepteur);
   writeByte(emetteur);
   // Acquittement
-  return workingAiguillage(recepteur);  // Renvoie un octet
+  return request(i, REQUETE_AIGUILLAGE, recepteur, callback);
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::statusAiguillage(byte module) {  // Voir p. 136
+byte Minitel::statusAiguillage(byte module) {
+  return (byte) waitReply(statusAiguillageAsync(module, NULL));  // 0 sans réponse
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::statusAiguillageAsync(byte module, MinitelCallback callback) {  // Voir p. 136
   // module peut prendre comme valeur :
   // CODE_EMISSION_ECRAN, CODE_EMISSION_CLAVIER, CODE_EMISSION_MODEM, CODE_EMISSION_PRISE
   // CODE_RECEPTION_ECRAN, CODE_RECEPTION_CLAVIER, CODE_RECEPTION_MODEM, CODE_RECEPTION_PRISE
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeBytesPRO(2);  // 0x1B 0x3A
   writeByte(TO);     // 0x62
   writeByte(module);
   // Acquittement
-  return workingAiguillage(module);  // Renvoie un octet
+  return request(i, REQUETE_AIGUILLAGE, module, callback);
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::connexion(boolean commande) {  // Voir p.139
+byte Minitel::connexion(boolean commande) {
+  return (byte) waitReply(connexionAsync(commande, NULL));  // 0 sans réponse
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::connexionAsync(boolean commande, MinitelCallback callback) {  // Voir p.139
   // Fonction proposée par iodeo sur GitHub en octobre 2021
   // commande peut prendre comme valeur :
   // true, false
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeBytesPRO(1);  // 0x1B 0x39
   writeByte(commande ? CONNEXION : DECONNEXION);  // 0x68 ou 0x67
   // Acquittement
-  return workingModem();  // Renvoie un octet
+  return request(i, REQUETE_MODEM, 0, callback);
+}
+/*--------------------------------------------------------------------*/
+
+byte Minitel::reset() {
+  return (byte) waitReply(resetAsync(NULL));  // 0 sans réponse
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::reset() {  // Voir p.145
+int Minitel::resetAsync(MinitelCallback callback) {  // Voir p.145
+  int i = reserveRequest();
+  if (i < 0) return -1;
   // Commande
   writeBytesPRO(1);  // 0x1B 0x39
   writeByte(RESET);  // 0x7F
+  trackColumns = 40;
+  trackScroll = false;
+  trackEcho = true;
+  trackKnown = false;
+  invalidateAttributes();
   // Acquittement
-  return workingStandard(0x135E);  // SEP (0x13), 0x5E
+  return request(i, REQUETE_STANDARD, 0x135E, callback);
 }
 /*--------------------------------------------------------------------*/
 
+void Minitel::poll() {
+  while (available() > 0) {
+    byte b = readByte();
+    COMPTER_LIGNE(received);  // A la vitesse de réception, avant un éventuel changement
+    receiveByte(b);
+  }
+#if defined(MINITEL_LINE_STATS)
+  unsigned long erreurs = parityErrors();
+  MinitelLineStats* compteurs = lineCounter();
+  if (compteurs != NULL && !speedProbing) compteurs->parityErrors += erreurs - lineParity;
+  lineParity = erreurs;
+#endif
+  // Trame interrompue (touche Esc seule...) : ses octets vont au clavier.
+  if (rxLength > 0 && millis() - rxTime > MINITEL_INTER_BYTE_TIMEOUT) {
+    if (rxExpected > 0) COMPTER_LIGNE(resyncs);  // Trame du protocole incomplète
+    releaseFrame();
+    endKey();
+  }
+  else if (keyState >= DECODAGE_ESC && millis() - keyTime > MINITEL_INTER_BYTE_TIMEOUT) {
+    endKey();
+  }
+  expireRequests();
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::replyStatus(int requete) {
+  if (requete < 0) return REPONSE_ECHEC;
+  Request& r = requests[requete % MINITEL_MAX_REQUESTS];
+  if (r.type == 0 || r.generation != requete / MINITEL_MAX_REQUESTS) return REPONSE_ECHEC;
+  return r.statut;
+}
+/*--------------------------------------------------------------------*/
+
+unsigned long Minitel::replyValue(int requete) {
+  int statut = replyStatus(requete);
+  if (requete < 0 || statut == REPONSE_ATTENTE) return 0;
+  Request& r = requests[requete % MINITEL_MAX_REQUESTS];
+  if (r.type == 0 || r.generation != requete / MINITEL_MAX_REQUESTS) return 0;
+  r.type = 0;  // La requête est libérée
+  return (statut == REPONSE_RECUE) ? r.valeur : 0;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::setReplyTimeout(unsigned long ms) {
+  replyTimeout = ms;
+}
+/*--------------------------------------------------------------------*/
+
+#if defined(ARDUINO)
+void Minitel::setSpeedCache(int adresse) {
+  speedCacheAddress = adresse;
+}
+#else
+void Minitel::setSpeedCache(const char* fichier) {
+  speedCacheFile = (fichier != NULL) ? fichier : "";
+}
+#endif
+/*--------------------------------------------------------------------*/
+
 
 
 
@@ -1014,59 +2111,123 @@ boolean Minitel::isDiacritic(unsigned char caractere) {  // Obsolète depuis le
 */
 /*--------------------------------------------------------------------*/
 
-boolean Minitel::isVisualisable(unsigned long code) {
-  // Fonction proposée par iodeo sur GitHub en février 2023
-  // Fonction utilisée dans getString(unsigned long code)
-  // Teste la conversion d'un code brut clavier en équivalent Unicode
-  // Renvoie 0 si le code ne correspond pas à un caractère visualisable
-  // Voir https://iodeo.github.io/MinitelKeyboardHelper/
-  
-  // Les caractères de contrôle ne sont pas visualisables
-  if (code < SP) return false;
-  // Les autres caractères de 7 bits sont visualisables
-  if (code <= DEL) return true;
-  switch (code) {
-    case 0x00A3: return true; // £
-    case 0x00A7: return true; // § (VGP5 seulement, pas VGP2 - voir p.90)
-    case 0x00B0: return true; // ° Ctrl 0 au clavier
-    case 0x00B1: return true; // ± Ctrl * au clavier
-    case 0x00BC: return true; // ¼
-    case 0x00BD: return true; // ½
-    case 0x00BE: return true; // ¾
-    /*  iodeo, je ne comprends pas cette partie car
-        aucune lettre accentuée majuscule n'est disponible sur le Minitel - voir page 90
-
-    case 0x00C0: return true; // À (VGP2)
-    case 0x00C7: return true; // Ç (VGP2)
-    case 0x00C8: return true; // È (VGP2)
-    case 0x00C9: return true; // É (VGP2)
-    */
-    case 0x00E0: return true; // à
-    case 0x00E2: return true; // â
-    case 0x00E4: return true; // ä (VGP5 seulement, pas VGP2 - voir p.90)
-    case 0x00E7: return true; // ç
-    case 0x00E8: return true; // è
-    case 0x00E9: return true; // é
-    case 0x00EA: return true; // ê
-    case 0x00EB: return true; // ë
-    case 0x00EE: return true; // î
-    case 0x00EF: return true; // ï
-    case 0x00F4: return true; // ô
-    case 0x00F6: return true; // ö (VGP5 seulement, pas VGP2 - voir p.90)
-    case 0x00F7: return true; // ÷ Ctrl 7 au clavier
-    case 0x00F9: return true; // ù
-    case 0x00FB: return true; // û
-    case 0x00FC: return true; // ü (VGP5 seulement, pas VGP2 - voir p.90)
-    case 0x0152: return true; // Œ
-    case 0x0153: return true; // œ
-    case 0x03B2: return true; // β (VGP5 seulement, pas VGP2 - voir p.90)
-    case 0x2014: return true; // — Ctrl 5 au clavier
-    case 0x2190: return true; // ← Ctrl 8 au clavier
-    case 0x2191: return true; // ↑
-    case 0x2192: return true; // → Ctrl 9 au clavier
-    case 0x2193: return true; // ↓ Ctrl # au clavier
-  }
-  return false; // Les caractères non listés sont supposés non visualisables
+void Minitel::printUtf8(MinitelTranscoder& utf8, const byte* source, size_t size) {
+  byte codes[32];
+  while (size > 0) {
+    size_t lus;
+    size_t n = utf8.transcode(source, size, codes, sizeof(codes), &lus);
+    for (size_t k=0; k<n; k++) writeByte(codes[k]);  // Suivi du curseur et répétitions
+    source += lus;
+    size -= lus;
+  }
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::readSpeedCache() {
+  // Vitesse mémorisée, 0 si aucune
+  int bauds = 0;
+#if !defined(ARDUINO)
+  FILE* f = speedCacheFile.empty() ? NULL : fopen(speedCacheFile.c_str(), "r");
+  if (f != NULL) {
+    if (fscanf(f, "%d", &bauds) != 1) bauds = 0;
+    fclose(f);
+  }
+#elif defined(__AVR__)
+  if (speedCacheAddress >= 0) bauds = EEPROM.read(speedCacheAddress) * 300;  // 1, 4, 16 ou 32
+#endif
+  return (bauds == 300 || bauds == 1200 || bauds == 4800 || bauds == 9600) ? bauds : 0;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::writeSpeedCache(int bauds) {
+  if (bauds == readSpeedCache()) return;  // Pas d'écriture inutile (l'EEPROM s'use)
+#if !defined(ARDUINO)
+  FILE* f = speedCacheFile.empty() ? NULL : fopen(speedCacheFile.c_str(), "w");
+  if (f != NULL) {
+    fprintf(f, "%d\n", bauds);
+    fclose(f);
+  }
+#elif defined(__AVR__)
+  if (speedCacheAddress >= 0) EEPROM.write(speedCacheAddress, bauds / 300);
+#else
+  (void) bauds;
+#endif
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::frame(int x1, int y1, int x2, int y2, boolean vider, const char* titre) {
+  // Bord supérieur, côtés, puis bord inférieur. Un côté coûte 3 octets par
+  // rangée (caractère, BS, LF ou VT) : les côtés sont tracés rangée par
+  // rangée (gauche, intérieur, droit) pour un panneau, dont l'intérieur est
+  // de toute façon écrit, ou pour un cadre quand c'est moins cher.
+  holdFlush();
+  byte fond = trackAttr[ATTR_FOND];  // Fond de l'intérieur d'un panneau
+  textMode();
+  moveCursorXY(x1,y1);
+  if (vider && fond != 0) attributs(fond);
+  // Titre centré dans le bord supérieur, tronqué si besoin
+  int largeur = x2 - x1 + 1;
+  int n = 0;  // Caractères du titre
+  size_t octets = 0;
+  if (titre != NULL) {
+    for (size_t i=0; titre[i] != 0; i++) {
+      if ((titre[i] & 0xC0) != 0x80) {  // Premier octet d'un caractère UTF-8
+        if (n == largeur - 2) break;
+        n++;
+      }
+      octets = i + 1;
+    }
+  }
+  boolean espaces = (n > 0 && n + 2 <= largeur - 2);
+  int total = n + (espaces ? 2 : 0);
+  int gauche = (largeur - total) / 2;
+  for (int x=0; x<gauche; x++) writeByte(0x5F);
+  if (n > 0) {
+    if (espaces) writeByte(SP);
+    print(titre, octets);
+    if (espaces) writeByte(SP);
+  }
+  for (int x=gauche+total; x<largeur; x++) writeByte(0x5F);
+  // Côtés
+  boolean parRangee = vider;
+  if (!parRangee) {
+    int aller = coutRelatif(x2 - x1 - 1);
+    int retour = coutRelatif(x1 - 1);  // En colonne 40, le curseur passe seul à la rangée suivante.
+    if (x2 < trackColumns) {
+      retour = (coutRelatif(x2 + 1 - x1) < 1 + coutRelatif(x1 - 1)) ? coutRelatif(x2 + 1 - x1) + 1 : coutRelatif(x1 - 1) + 2;
+    }
+    parRangee = (2 + aller + retour < 6);
+  }
+  if (parRangee) {
+    for (int y=y1+1; y<y2; y++) {
+      moveCursorXY(x1,y);
+      if (vider && fond != 0) attributs(fond);
+      writeByte(0x7B);
+      if (vider) {
+        for (int x=x1+1; x<x2; x++) writeByte(SP);  // Codé par REP
+      }
+      else {
+        moveCursorXY(x2,y);
+      }
+      writeByte(0x7D);
+    }
+    moveCursorXY(x1,y2);
+    for (int x=x1; x<=x2; x++) writeByte(0x7E);
+  }
+  else {
+    // Côté droit en descendant, bord inférieur, côté gauche en remontant
+    for (int y=y1+1; y<y2; y++) {
+      moveCursorXY(x2,y);
+      writeByte(0x7D);
+    }
+    moveCursorXY(x1,y2);
+    for (int x=x1; x<=x2; x++) writeByte(0x7E);
+    for (int y=y2-1; y>y1; y--) {
+      moveCursorXY(x1,y);
+      writeByte(0x7B);
+    }
+  }
+  releaseFlush();
 }
 /*--------------------------------------------------------------------*/
 
@@ -1092,155 +2253,1107 @@ void Minitel::writeBytesPRO(int n) {  // Voir p.134
 }
 /*--------------------------------------------------------------------*/
 
-unsigned long Minitel::identificationBytes() {  // Voir p.138
-  while (!isListening());  // On attend que le port soit sur écoute.
-  unsigned long trame = 0;  // 32 bits = 4 octets
-  while (trame >> 24 != 0x01) {  // La trame doit débuter par SOH (0x01)
-    if (available() > 0) {
-      trame = (trame << 8) + readByte();
+int Minitel::reserveRequest() {
+  // Place pour la réponse, prise avant d'écrire la commande : sans place,
+  // la commande n'est pas envoyée (sa réponse passerait pour des touches).
+  // Une place libre d'abord, sinon celle de la plus ancienne requête
+  // terminée dont la valeur n'a pas été lue (sans callback).
+  expireRequests();
+  int choix = -1;
+  for (byte i=0; i<MINITEL_MAX_REQUESTS; i++) {
+    Request& r = requests[i];
+    if (r.type == 0) {
+      choix = i;
+      break;
+    }
+    if (r.type != REQUETE_RESERVEE && r.statut != REPONSE_ATTENTE
+        && (choix < 0 || (long) (r.debut - requests[choix].debut) < 0)) {
+      choix = i;
+    }
+  }
+  if (choix < 0) return -1;  // Trop de requêtes en attente
+  Request& r = requests[choix];
+  r.type = REQUETE_RESERVEE;
+  r.statut = REPONSE_ECHEC;  // Aucune réponse ne lui correspond encore
+  r.callback = NULL;
+  if (++r.generation > 100) r.generation = 1;  // L'ancien numéro est périmé
+  return choix;
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::request(byte i, byte type, unsigned long parametre, MinitelCallback callback) {
+  // Enregistre l'attente d'une réponse du Minitel dans la place i (voir
+  // reserveRequest). La commande correspondante vient d'être écrite : elle
+  // part maintenant.
+  flush();
+  Request& r = requests[i];
+  r.type = type;
+  r.parametre = parametre;
+  r.statut = REPONSE_ATTENTE;
+  r.valeur = 0;
+  r.debut = millis();
+  // Sans acquittement d'un changement de standard au bout de 100 ms, on
+  // peut supposer que le mode demandé était déjà actif.
+  r.delai = (type == REQUETE_STANDARD) ? 100 : replyTimeout;
+  r.callback = callback;
+  return r.generation * MINITEL_MAX_REQUESTS + i;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::expireRequests() {
+  for (byte i=0; i<MINITEL_MAX_REQUESTS; i++) {
+    Request& r = requests[i];
+    if (r.type != 0 && r.statut == REPONSE_ATTENTE && millis() - r.debut >= r.delai) {
+      // Le délai d'un changement de standard n'est pas un échec (voir request).
+      if (r.type != REQUETE_STANDARD) COMPTER_LIGNE(timeouts);
+      completeRequest(i, REPONSE_ECHEC);
     }
   }
-  while (!available()>0); // Indispensable
-  if (readByte() != 0x04) return 0;  // La trame doit se terminer par EOT (0x04)
-  trame = (trame << 8) >> 8;  // On élimine l'octet SOH (0x01) de la trame
-  return trame;  // 3 octets
-                 // octet définissant le constructeur du Minitel
-                 // octet définissant le type du Minitel
-                 // octet définissant la version du logiciel
 }
 /*--------------------------------------------------------------------*/
 
-int Minitel::workingSpeed() {
-  int bauds = -1;
-  while (!isListening());  // On attend que le port soit sur écoute.
-  unsigned long time = millis();
-  unsigned long duree = 0;
-  unsigned long trame = 0;  // 32 bits = 4 octets
-  // On se donne 1000 ms pour récupérer une trame exploitable
-  while ((trame >> 8 != 0x1B3A75) && (duree < 1000)) {  // Voir p.141
-    if (available() > 0) {
-      trame = (trame << 8) + readByte();
-      //Serial.println(trame, HEX);
+unsigned long Minitel::waitReply(int requete) {
+  while (replyStatus(requete) == REPONSE_ATTENTE) {
+    poll();
+  }
+  return replyValue(requete);
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::receiveByte(byte b) {
+  // Découpage du flux reçu en trames : réponses du protocole (PRO1, PRO2,
+  // PRO3, SEP, SOH ... EOT, US, CSI ?) ou octets du clavier.
+  rxFrame[rxLength++] = b;
+  rxTime = millis();
+  if (rxLength == 1) {
+    switch (b) {
+      case ESC  : rxExpected = 0; return;  // Longueur connue à l'octet suivant
+      case 0x13 : rxExpected = 2; return;  // SEP
+      case 0x01 : rxExpected = 5; return;  // SOH, 3 octets, EOT
+      case US   : rxExpected = 3; return;  // Position du curseur
+    }
+    releaseFrame();  // Octet isolé du clavier
+    return;
+  }
+  if (rxFrame[0] == ESC) {
+    if (rxLength == 2) {
+      switch (b) {
+        case 0x39 : rxExpected = 3; return;  // PRO1
+        case 0x3A : rxExpected = 4; return;  // PRO2
+        case 0x3B : rxExpected = 5; return;  // PRO3
+        case 0x5B : return;                  // CSI
+      }
+    }
+    else if (rxLength == 3 && rxExpected == 0 && b == 0x3F) {  // CSI ?
+      rxExpected = 4;
+      return;
+    }
+    if (rxExpected == 0) {  // Séquence du clavier (touche Esc, touches du curseur...)
+      releaseFrame();
+      return;
+    }
+  }
+  if (rxFrame[0] == 0x01 && b == 0x04) rxExpected = rxLength;  // EOT
+  if (rxLength < rxExpected) return;
+  // Trame complète. Elle est copiée avant d'être traitée : un callback
+  // peut lui-même attendre une réponse et donc recevoir d'autres octets.
+  byte trame[6];
+  byte longueur = rxLength;
+  for (byte i=0; i<longueur; i++) trame[i] = rxFrame[i];
+  rxLength = 0;
+  for (byte i=0; i<longueur; i++) {
+    if (trame[i] == 0xFF) {  // Erreur de parité (voir readByte) : trame perdue
+      COMPTER_LIGNE(resyncs);
+      break;
     }
-    duree = millis() - time;
   }
-  switch (trame) {
-    case 0x1B3A7552 : bauds =  300; break;
-    case 0x1B3A7564 : bauds = 1200; break;
-    case 0x1B3A7576 : bauds = 4800; break;
-    case 0x1B3A757F : bauds = 9600; break;  // Pour le Minitel 2 seulement
+  // La plus ancienne requête qui attend ce type de réponse l'emporte.
+  int plusAncienne = -1;
+  for (byte i=0; i<MINITEL_MAX_REQUESTS; i++) {
+    Request& r = requests[i];
+    if (r.type != 0 && r.statut == REPONSE_ATTENTE && matchReply(r, trame, longueur)
+        && (plusAncienne < 0 || (long) (r.debut - requests[plusAncienne].debut) < 0)) {
+      plusAncienne = i;
+    }
+  }
+  if (plusAncienne >= 0) {
+    COMPTER_LIGNE(replies);
+#if defined(MINITEL_STATS)
+    statsData.replyBytes += longueur;
+#endif
+    matchReply(requests[plusAncienne], trame, longueur);  // La valeur est celle de cette requête
+    completeRequest(plusAncienne, REPONSE_RECUE);
+    return;
+  }
+  // Aucune requête ne l'attendait : c'est une frappe au clavier.
+  for (byte i=0; i<longueur; i++) rxFrame[i] = trame[i];
+  rxLength = longueur;
+  releaseFrame();
+}
+/*--------------------------------------------------------------------*/
+
+boolean Minitel::matchReply(Request& r, const byte* trame, byte longueur) {
+  // Vérifie que la trame répond à la requête r et en extrait la valeur.
+  switch (r.type) {
+    case REQUETE_VITESSE :  // Voir p.141
+      // PRO2 (0x1B,0x3A), REP_STATUS_VITESSE (0x75), octet de vitesse
+      if (longueur != 4 || trame[1] != 0x3A || trame[2] != 0x75) return false;
+      switch (trame[3]) {
+        case 0x52 : r.valeur =  300; break;
+        case 0x64 : r.valeur = 1200; break;
+        case 0x76 : r.valeur = 4800; break;
+        case 0x7F : r.valeur = 9600; break;  // Pour le Minitel 2 seulement
+        default   : r.valeur = 0;
+      }
+      return true;
+    case REQUETE_STANDARD : {
+      // Séquence attendue de 2 à 4 octets : SEP (0x13) 0x5E, SEP 0x70...
+      if (longueur > 4) return false;
+      unsigned long sequence = 0;
+      for (byte i=0; i<longueur; i++) sequence = (sequence << 8) + trame[i];
+      if (sequence != r.parametre) return false;
+      r.valeur = 1;
+      return true;
+    }
+    case REQUETE_FONCTIONNEMENT :  // Voir p.143
+      // PRO2 (0x1B,0x3A), REP_STATUS_FONCTIONNEMENT (0x73), octet de statut.
+      // On récupère notamment les 4 bits de poids faibles suivants : ME PC RL F
+      // ME : mode minuscules / majuscules du clavier (1 = minuscule)
+      // PC : PCE (1 = actif)
+      // RL : rouleau (1 = actif)
+      // F  : format d'écran (1 = 80 colonnes)
+      if (longueur != 4 || trame[1] != 0x3A || trame[2] != 0x73) return false;
+      r.valeur = trame[3];
+      return true;
+    case REQUETE_CLAVIER :  // Voir p.142
+      // PRO3 (0x1B,0x3B), REP_STATUS_CLAVIER (0x73), CODE_RECEPTION_CLAVIER (0x59), octet de statut.
+      // On récupère notamment les 3 bits de poids faibles suivants : C0 0 Eten
+      // Eten : mode étendu (1 = actif)
+      // C0   : codage en jeu C0 des touches de gestion du curseur (1 = actif)
+      if (longueur != 5 || trame[1] != 0x3B || trame[2] != 0x73 || trame[3] != CODE_RECEPTION_CLAVIER) return false;
+      r.valeur = trame[4];
+      return true;
+    case REQUETE_AIGUILLAGE :  // Voir p.136
+      // PRO3 (0x1B,0x3B), FROM (0x63), code réception ou émission du module,
+      // octet de statut d'aiguillage associé au module :
+      // b7 : bit de parité
+      // b6 : 1
+      // b5 : 0
+      // b4 : 0
+      // b3 : prise
+      // b2 : modem             1 : liaison établie
+      // b1 : clavier           0 : liaison coupée
+      // b0 : écran
+      // L'octet de statut contient également l'état de la ressource que constitue le module lui-même (0 : module bloqué ; 1 : module actif)
+      if (longueur != 5 || trame[1] != 0x3B || trame[2] != FROM || trame[3] != r.parametre) return false;
+      r.valeur = trame[4];
+      return true;
+    case REQUETE_MODEM :  // Voir p.126
+      // Fonction proposée par iodeo sur GitHub en octobre 2021
+      // On récupère uniquement la séquence immédiate SEP (0x13) 0x5X
+      // en cas de connexion confirmé, la séquence 0x1353 s'ajoutera - non traité ici
+      // en cas de timeout (environ 40sec), la séquence 0x1359 s'ajoutera - non traité ici
+      // (SEP 0x41 à 0x49 : touches de fonction ; SEP 0x5E : acquittement de reset)
+      if (longueur != 2 || trame[0] != 0x13 || trame[1] < 0x50 || trame[1] > 0x5D) return false;
+      r.valeur = trame[1];
+      return true;
+    case REQUETE_IDENTIFICATION :  // Voir p.138
+      // SOH (0x01), 3 octets, EOT (0x04)
+      if (longueur != 5 || trame[0] != 0x01 || trame[4] != 0x04) return false;
+      r.valeur = ((unsigned long) trame[1] << 16) | ((unsigned long) trame[2] << 8) | trame[3];
+      return true;
+    case REQUETE_CURSEUR :  // Voir p.98
+      // US (0x1F), rangée, colonne
+      if (longueur != 3 || trame[0] != US) return false;
+      r.valeur = ((unsigned long) US << 16) | ((unsigned long) trame[1] << 8) | trame[2];
+      return true;
   }
-  return bauds;
+  return false;
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::workingStandard(unsigned long sequence) {
-  // Fonction modifiée par iodeo sur GitHub en octobre 2021
-  while (!isListening());  // On attend que le port soit sur écoute.
-  unsigned long time = millis();
-  unsigned long duree = 0;
-  unsigned long trame = 0;  // 32 bits = 4 octets  
-  // On se donne 100ms pour recevoir l'acquittement
-  // Sinon, on peut supposer que le mode demandé était déjà actif
-  while ((trame != sequence) && (duree < 100)) {
-    if (available() > 0) {
-      trame = (trame << 8) + readByte();
-      //Serial.println(trame, HEX);
-    }
-    duree = millis() - time;
+#if defined(MINITEL_LINE_STATS)
+MinitelLineStats* Minitel::lineCounter() {
+  // Compteurs de la vitesse en cours, NULL si elle n'est pas connue
+  int k = rangVitesse(lineSpeed);
+  return (k < 0) ? NULL : &lineCounters[k];
+}
+/*--------------------------------------------------------------------*/
+#endif
+
+#if defined(MINITEL_STATS)
+void Minitel::statsByte(byte b) {
+  // Catégorie de l'octet émis, d'après la séquence en cours (voir trackByte).
+  // ESC est compté avec l'octet qui le suit, qui dit ce qu'il introduit.
+  byte categorie;
+  switch (trackState) {
+    case SUIVI_ESC :
+      if (b == 0x5B) categorie = STATS_CURSEUR;  // CSI
+      else if (attrIndex(b) >= 0) categorie = STATS_ATTRIBUTS;
+      else categorie = STATS_PROTOCOLE;  // PRO1 à PRO3...
+      statsData.sent[categorie]++;
+      statsTotal++;
+      break;
+    case SUIVI_CSI :
+    case SUIVI_US :
+    case SUIVI_US2 :
+      categorie = STATS_CURSEUR;
+      break;
+    case SUIVI_SS2 :
+    case SUIVI_DIACRITIQUE :
+      categorie = STATS_TEXTE;
+      break;
+    case SUIVI_REP :
+      categorie = statsLast;
+      break;
+    case SUIVI_PRO :
+      categorie = STATS_PROTOCOLE;
+      break;
+    default :
+      if (b >= SP) {
+        categorie = (trackAttr[ATTR_JEU] == SO) ? STATS_MOSAIQUE : STATS_TEXTE;
+        statsLast = categorie;
+        break;
+      }
+      switch (b) {
+        case ESC : return;
+        case SO : case SI : categorie = STATS_ATTRIBUTS; break;
+        case SS2 : categorie = statsLast = STATS_TEXTE; break;
+        case REP : categorie = statsLast; break;
+        case BS : case HT : case LF : case VT : case FF : case CR : case RS : case US : case CAN :
+          categorie = STATS_CURSEUR;
+          break;
+        default : categorie = STATS_PROTOCOLE;  // BEL, CON, COFF...
+      }
   }
-  return (trame == sequence)? 1 : 0;
+  statsData.sent[categorie]++;
+  statsTotal++;
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::workingMode() {  // Voir p.143
-  // On récupère notamment les 4 bits de poids faibles suivants : ME PC RL F
-  // ME : mode minuscules / majuscules du clavier (1 = minuscule)
-  // PC : PCE (1 = actif)
-  // RL : rouleau (1 = actif)
-  // F  : format d'écran (1 = 80 colonnes)
-  while (!isListening());  // On attend que le port soit sur écoute.
-  unsigned long trame = 0;  // 32 bits = 4 octets  
-  while (trame >> 8 != 0x1B3A73) {  // PRO2 (0x1B,0x3A), REP_STATUS_FONCTIONNEMENT (0x73)
-    if (available() > 0) {
-      trame = (trame << 8) + readByte();
-      //Serial.println(trame, HEX);
-    }
+void Minitel::statsReply(byte type, int statut, unsigned long debut) {
+  int i;
+  switch (type) {
+    case REQUETE_IDENTIFICATION : i = STATS_IDENTIFICATION; break;
+    case REQUETE_VITESSE : i = STATS_VITESSE; break;
+    case REQUETE_CURSEUR : i = STATS_POSITION; break;
+    default : return;
+  }
+  if (speedProbing) return;  // Vitesses essayées par searchSpeed
+  MinitelLatency& l = statsData.latency[i];
+  if (statut != REPONSE_RECUE) {
+    l.timeouts++;
+    return;
+  }
+  unsigned long duree = millis() - debut;
+  if (l.replies == 0 || duree < l.fastest) l.fastest = duree;
+  if (duree > l.slowest) l.slowest = duree;
+  l.total += duree;
+  l.replies++;
+}
+/*--------------------------------------------------------------------*/
+
+Minitel::StatsCall::StatsCall(Minitel* minitel, byte famille) : minitel(minitel), famille(famille) {
+  debut = minitel->statsTotal;
+  minitel->statsDepth++;
+}
+/*--------------------------------------------------------------------*/
+
+Minitel::StatsCall::~StatsCall() {
+  if (--minitel->statsDepth > 0) return;  // Appel fait par une autre fonction comptée
+  minitel->statsData.calls[famille]++;
+  minitel->statsData.callBytes[famille] += minitel->statsTotal - debut;
+}
+/*--------------------------------------------------------------------*/
+#endif
+
+void Minitel::completeRequest(byte i, int statut) {
+  Request& r = requests[i];
+  r.statut = statut;
+#if defined(MINITEL_STATS)
+  statsReply(r.type, statut, r.debut);
+#endif
+  if (r.callback != NULL) {
+    // La requête est libérée avant l'appel : le callback peut en lancer une autre.
+    MinitelCallback callback = r.callback;
+    r.type = 0;
+    callback(r.generation * MINITEL_MAX_REQUESTS + i, statut, r.valeur);
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::releaseFrame() {
+  // Les octets de la trame en cours viennent du clavier.
+  for (byte i=0; i<rxLength; i++) {
+    decodeKey(rxFrame[i]);
   }
-  return (byte) trame;
+  rxLength = 0;
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::workingKeyboard() {  // Voir p.142
-  // On récupère notamment les 3 bits de poids faibles suivants : C0 0 Eten
-  // Eten : mode étendu (1 = actif)
-  // C0   : codage en jeu C0 des touches de gestion du curseur (1 = actif)
-  while (!isListening());  // On attend que le port soit sur écoute.
-  unsigned long trame = 0;  // 32 bits = 4 octets  
-  while (trame != 0x1B3B7359) {  // PRO3 (0x1B,0x3B), REP_STATUS_CLAVIER (0x73), CODE_RECEPTION_CLAVIER (0x59)
-    if (available() > 0) {
-      trame = (trame << 8) + readByte();
-      //Serial.println(trame, HEX);
+void Minitel::decodeKey(byte b) {
+  // Décodage octet par octet des séquences de un à quatre codes émises
+  // par le clavier (voir p.118 à 124).
+  unsigned long unicode;
+  switch (keyState) {
+    case DECODAGE_SS2 :
+      keyCode = (keyCode << 8) + b;
+      if (b == ACCENT_GRAVE || b == ACCENT_AIGU || b == ACCENT_CIRCONFLEXE || b == TREMA || b == CEDILLE) {
+        keyState = DECODAGE_DIACRITIQUE;  // Séquence de 3 codes
+        return;
+      }
+      // Les autres caractères spéciaux disponibles sous Arduino (2 codes)
+      unicode = MinitelTranscoder::unicodeCode(keyCode);
+      pushKey(keyCode, (unicode != 0) ? unicode : keyCode);
+      return;
+    case DECODAGE_DIACRITIQUE :
+      if (b == SS2) {
+        // Bug 1 : Pour éviter de compter un caractère lorsqu'on appuie plusieurs fois de suite sur une touche avec accent ou tréma
+        keyState = DECODAGE_IGNORE;
+      }
+      else if (b == 0x13) {
+        // Bug 2 : Pour éviter de compter un caractère lorsqu'on appuie sur les touches de fonction après avoir appuyé sur une touche avec accent ou tréma
+        keyState = DECODAGE_PERDU;  // Les touches de fonction sont codées sur 2 octets (0x13..)
+      }
+      else {
+        keyCode = (keyCode << 8) + b;
+        unicode = MinitelTranscoder::unicodeCode(keyCode);
+        pushKey(keyCode, (unicode != 0) ? unicode : b);
+      }
+      return;
+    case DECODAGE_IGNORE :
+      keyState = DECODAGE_DIACRITIQUE;
+      return;
+    case DECODAGE_PERDU :
+      keyState = DECODAGE_NORMAL;
+      return;
+    case DECODAGE_SEP :  // Touches de fonction (voir p.123)
+      keyCode = (keyCode << 8) + b;
+      pushKey(keyCode, keyCode);
+      return;
+    // Touches de gestion du curseur lorsque le clavier est en mode étendu (voir p.124)
+    // Pour passer au clavier étendu manuellement : Fnct C + E
+    // Pour revenir au clavier vidéotex standard  : Fnct C + V
+    case DECODAGE_ESC :
+      keyCode = (keyCode << 8) + b;
+      keyTime = millis();
+      if (b == 0x5B) keyState = DECODAGE_CSI;
+      else pushKey(keyCode, keyCode);
+      return;
+    case DECODAGE_CSI :
+      keyCode = (keyCode << 8) + b;
+      keyTime = millis();
+      if (b == 0x34 || b == 0x32) keyState = DECODAGE_CSI_PARAM;
+      else pushKey(keyCode, keyCode);
+      return;
+    case DECODAGE_CSI_PARAM :
+      keyCode = (keyCode << 8) + b;
+      pushKey(keyCode, keyCode);
+      return;
+  }
+  // Premier octet d'une touche
+  if (b == 0) return;
+  keyCode = b;
+  keyTime = millis();
+  switch (b) {
+    case SS2  : keyState = DECODAGE_SS2; return;
+    case 0x13 : keyState = DECODAGE_SEP; return;
+    case ESC  : keyState = DECODAGE_ESC; return;  // 0x1B seul correspond à la touche Esc.
+  }
+  unicode = MinitelTranscoder::unicodeCode(b);
+  pushKey(b, (unicode != 0) ? unicode : b);
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::endKey() {
+  // Plus d'octet depuis MINITEL_INTER_BYTE_TIMEOUT : la séquence
+  // commencée par ESC est complète (touche Esc seule...).
+  if (keyState >= DECODAGE_ESC) pushKey(keyCode, keyCode);
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::pushKey(unsigned long code, unsigned long unicode) {
+  keyState = DECODAGE_NORMAL;
+  if (trackEcho) invalidateCursor();  // L'écho de la touche a déplacé le curseur
+  if (keyCount == MINITEL_KEY_EVENTS) return;  // Touche perdue : personne ne lit le clavier
+  MinitelKeyEvent& touche = keyEvents[(keyStart + keyCount) % MINITEL_KEY_EVENTS];
+  touche.code = code;
+  touche.unicode = unicode;
+  touche.time = keyTime;
+  keyCount++;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::sendByte(byte b) {
+  // Le bit de parité est mis à 0 si la somme des autres bits est paire
+  // et à 1 si elle est impaire (voir la table PARITE plus haut).
+  // En parité native, c'est le port série qui s'en charge.
+  trackByte(b);  // Suivi de la position du curseur et des attributs
+  b = nativeParity ? b : (b | bitParite(b));  // Ecriture du bit de parité
+  bufferByte(b);  // Envoi de l'octet sur le port série (via le tampon d'émission)
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::startPage(byte source, const byte* page, size_t size) {
+  endPage();
+  pageSource = source;
+  pageData = page;
+  pageSize = size;
+  pageOffset = 0;
+  pageLookahead = -1;
+  pageCredit = MINITEL_PAGE_CHUNK * 10000UL;  // Le premier bloc part aussitôt (voir le plafond de streamPage).
+  pageClock = millis();
+  if (size == 0) endPage();
+}
+/*--------------------------------------------------------------------*/
+
+size_t Minitel::pageRead(byte* bloc, size_t n) {
+  // Lit les n octets suivants de la page (sans les compter comme envoyés)
+  size_t lus = 0;
+  if (n > 0 && pageLookahead >= 0) {
+    bloc[lus++] = (byte) pageLookahead;
+    pageLookahead = -1;
+  }
+  switch (pageSource) {
+    case PAGE_MEMOIRE :
+    case PAGE_PROJETEE :
+      for (; lus<n; lus++) bloc[lus] = pageData[pageOffset + lus];
+      break;
+    case PAGE_FLASH :
+      for (; lus<n; lus++) bloc[lus] = pgm_read_byte(pageData + pageOffset + lus);
+      break;
+    case PAGE_COMPRESSEE :
+      if (lus < n) lus += pagePacked->read(bloc + lus, n - lus);
+      break;
+#if defined(ARDUINO)
+    case PAGE_FICHIER :
+      if (lus < n) lus += pageFile->readBytes((char*) bloc + lus, n - lus);
+      break;
+#endif
+  }
+  return lus;
+}
+/*--------------------------------------------------------------------*/
+
+int Minitel::pagePeek() {
+  // Prochain octet de la page, -1 à la fin
+  if (pageSource == PAGE_AUCUNE || pageOffset >= pageSize) return -1;
+  if (pageLookahead < 0) {
+    byte b;
+    if (pageRead(&b, 1) == 1) pageLookahead = b;
+  }
+  int b = pageLookahead;
+  if (pageSource != PAGE_COMPRESSEE && pageSource != PAGE_FICHIER) pageLookahead = -1;  // Relu sur place
+  return b;
+}
+/*--------------------------------------------------------------------*/
+
+boolean Minitel::pageSafe() {
+  // Point de reprise : aucune séquence en cours, position et attributs
+  // connus (pour y revenir), hors de la rangée 0 et pas juste avant un
+  // REP (qui répéterait le dernier caractère de l'écho). Masquage et lignage
+  // inconnus sont supposés par défaut (voir endOverlay) ; taille et
+  // inversion ne servent pas en mode graphique. Les attributs de zone
+  // validés doivent être ceux par défaut, sauf si la page écrit ensuite un
+  // délimiteur (espace, ou tout caractère semi-graphique) qui les valide de
+  // nouveau, ou une case que endOverlay peut valider avant elle.
+  if (trackState != SUIVI_NORMAL || !trackKnown || trackY < 1) return false;
+  boolean texte = (trackAttr[ATTR_JEU] == SI);
+  for (int i=0; i<8; i++) {
+    if (trackAttr[i] != 0 || i == ATTR_MASQUAGE || i == ATTR_LIGNAGE) continue;
+    if (texte || (i != ATTR_TAILLE && i != ATTR_INVERSION)) return false;
+  }
+  int suivant = pagePeek();
+  if (suivant < 0) return true;
+  suivant &= 0x7F;
+  if (suivant == REP) return false;
+  if (texte ? (suivant == 0x20) : (suivant >= 0x20)) return true;  // Délimiteur
+  boolean defaut = true;
+  for (int i=0; i<3; i++) {
+    if (trackZone[i] == 0 && i == 0) return false;
+    if (trackZone[i] != 0 && trackZone[i] != ATTR_DEFAUT[ATTR_FOND + i]) defaut = false;
+  }
+  // Pas en dernière colonne : l'espace de endOverlay changerait de rangée.
+  return defaut || (texte && (suivant > 0x20 || suivant == SS2) && trackX < trackColumns);
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::pageBoundary(boolean strict) {
+  // Envoie la page octet par octet jusqu'au prochain point de reprise
+  // (strict), ou seulement jusqu'à la fin de la séquence en cours. Au-delà
+  // de REPRISE_MAX octets, on s'en contente tel quel.
+  for (int i=0; i<REPRISE_MAX && pageOffset < pageSize; i++) {
+    if (strict ? pageSafe() : (trackState == SUIVI_NORMAL && (pagePeek() & 0x7F) != REP)) return;
+    byte b;
+    if (pageRead(&b, 1) == 0) return;
+    sendBytes(&b, 1);
+    pageOffset++;
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::sendStatus() {
+  const char* texte = statusText;
+  statusText = NULL;
+  beginOverlay();
+  newXY(1, 0);
+  print(texte);
+  int n = 0;  // Caractères (et non octets UTF-8)
+  for (const char* c=texte; *c; c++) {
+    if ((*c & 0xC0) != 0x80) n++;
+  }
+  if (n < 40) writeByte(CAN);  // Reste de l'ancien texte
+  endOverlay();
+}
+/*--------------------------------------------------------------------*/
+
+boolean Minitel::repeatByte(byte b) {
+  // Renvoie true si b prolonge une suite de caractères identiques : il est
+  // alors compté dans repeatCount au lieu d'être envoyé (voir flushRepeat).
+  // Un caractère du jeu G2 (SS2 + code) se répète comme un tout : SS2 est
+  // retenu jusqu'à l'octet suivant.
+  if (repeatSS2) {
+    repeatSS2 = false;
+    if (b == repeatChar) {
+      repeatCount++;
+      return true;
+    }
+    flushRepeat();
+    sendByte(SS2);
+  }
+  else if (trackState == SUIVI_NORMAL && repeatChar != 0) {
+    if (!repeatG2 && b == repeatChar) {
+      repeatCount++;
+      return true;
     }
+    if (repeatG2 && b == SS2) {
+      repeatSS2 = true;
+      return true;
+    }
+  }
+  flushRepeat();
+  // Caractère que b va visualiser (les lettres accentuées ne sont pas répétées)
+  if (b >= SP && (trackState == SUIVI_NORMAL || (trackState == SUIVI_SS2 && (b < 0x40 || b > 0x4F)))) {
+    repeatChar = b;
+    repeatG2 = (trackState == SUIVI_SS2);
+  }
+  else {
+    repeatChar = 0;
   }
-  while (!available()>0);  // Indispensable
-  return readByte(); // Octet de statut fonctionnement clavier
+  return false;
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::workingAiguillage(byte module) {  // Voir p.136
-  // On récupère l'octet de statut d'aiguillage associé à un module :
-  // b7 : bit de parité
-  // b6 : 1
-  // b5 : 0
-  // b4 : 0
-  // b3 : prise
-  // b2 : modem             1 : liaison établie
-  // b1 : clavier           0 : liaison coupée
-  // b0 : écran
-  // L'octet de statut contient également l'état de la ressource que constitue le module lui-même (0 : module bloqué ; 1 : module actif)
-  while (!isListening());  // On attend que le port soit sur écoute.
-  unsigned long trame = 0;  // 32 bits = 4 octets
-  while (trame != (0x1B3B63 << 8 | module)) {  // PRO3 (0x1B,0x3B), FROM (0x63), code réception ou émission du module
-    if (available() > 0) {
-      trame = (trame << 8) + readByte();
-      //Serial.println(trame, HEX);
+void Minitel::flushRepeat() {
+  // Envoie les répétitions en attente : REP (2 octets, 63 répétitions au
+  // plus, voir p.98) quand c'est plus court que de renvoyer le caractère.
+  unsigned int n = repeatCount;
+  boolean ss2 = repeatSS2;
+  repeatCount = 0;  // Avant tout envoi : sendByte peut rappeler flush()
+  repeatSS2 = false;
+  byte longueur = repeatG2 ? 2 : 1;
+  while (n > 0) {
+    byte k = (n > 63) ? 63 : n;
+    if (k * longueur > 2) {
+      sendByte(REP);
+      sendByte(0x40 + k);
     }
+    else {
+      for (byte i=0; i<k; i++) {
+        if (repeatG2) sendByte(SS2);
+        sendByte(repeatChar);
+      }
+    }
+    n -= k;
   }
-  while (!available()>0);  // Indispensable
-  return readByte(); // Octet de statut associé à un module
+  if (ss2) sendByte(SS2);
 }
 /*--------------------------------------------------------------------*/
 
-byte Minitel::workingModem() {  // Voir p.126
-  // Fonction proposée par iodeo sur GitHub en octobre 2021
-  // On récupère uniquement la séquence immédiate 0x1359
-  // en cas de connexion confirmé, la séquence 0x1353 s'ajoutera - non traité ici
-  // en cas de timeout (environ 40sec), la séquence 0x1359 s'ajoutera - non traité ici
-  while (!isListening());  // On attend que le port soit sur écoute.
-  unsigned int trame = 0;  // 16 bits = 2 octets
-  while (trame >> 8 != 0x13) {
-    if (available() > 0) {
-      trame = (trame << 8) + readByte();
-      //Serial.println(trame, HEX);
+void Minitel::bufferByte(byte b) {
+  if (txCount == MINITEL_TX_BUFFER_SIZE) {
+    flush();  // Tampon plein
+  }
+  txBuffer[(txStart + txCount) % MINITEL_TX_BUFFER_SIZE] = b;
+  txCount++;
+  if (txHold == 0 && txCount >= txThreshold) {
+    flush();
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::holdFlush() {
+  // Les fonctions qui émettent plusieurs octets encadrent leur travail par
+  // holdFlush() et releaseFlush() afin que l'ensemble parte en un seul bloc.
+  txHold++;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::releaseFlush() {
+  if (txHold > 0) txHold--;
+  if (txHold == 0 && txCount + repeatCount >= txThreshold) {
+    flush();
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::moveRelative(int n, byte code, byte final) {
+  // n codes simples ou CSI Pn final, selon ce qui est le plus court
+  if (n < ((n > 9) ? 5 : 4)) {
+    for (int i=0; i<n; i++) writeByte(code);
+  }
+  else {
+    writeWord(CSI);  // 0x1B 0x5B
+    writeBytesP(n);
+    writeByte(final);
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::trackByte(byte b) {
+  // Met à jour la position supposée du curseur d'après l'octet émis.
+  // Dans le doute, la position est déclarée inconnue.
+#if defined(MINITEL_STATS)
+  statsByte(b);
+#endif
+  switch (trackState) {
+    case SUIVI_ESC :
+      trackState = SUIVI_NORMAL;
+      if (b == 0x5B) {  // CSI
+        trackState = SUIVI_CSI;
+        trackCount = 0;
+        trackParam[0] = trackParam[1] = 0;
+      }
+      else if (b >= 0x39 && b <= 0x3B) {  // PRO1, PRO2, PRO3 : 1 à 3 octets suivent
+        trackState = SUIVI_PRO;
+        trackCount = b - 0x38;
+      }
+      else if (attrIndex(b) >= 0) {
+        int i = attrIndex(b);
+        // Taille et inversion ne sont pas utilisables en mode graphique :
+        // dans le doute, l'attribut devient inconnu.
+        boolean ignore = (i == ATTR_TAILLE || i == ATTR_INVERSION) && trackAttr[ATTR_JEU] != SI;
+        trackAttr[i] = ignore ? 0 : b;
+      }
+      return;
+    case SUIVI_CSI :
+      if (b >= 0x30 && b <= 0x39) {
+        if (trackParam[trackCount] < 25) trackParam[trackCount] = trackParam[trackCount]*10 + (b - 0x30);
+        return;
+      }
+      if (b == 0x3B) {
+        if (trackCount == 0) trackCount = 1;
+        return;
+      }
+      trackState = SUIVI_NORMAL;
+      if (b == 0x48) {  // H : adressage absolu
+        trackRow(trackParam[0]);
+        trackKnown = (trackParam[0] >= 1 && trackParam[0] <= 24 && trackParam[1] <= trackColumns);
+        trackX = trackParam[1] ? trackParam[1] : 1;
+        trackY = trackParam[0];
+        return;
+      }
+      if (trackParam[0] == 0) trackParam[0] = 1;
+      switch (b) {
+        case 0x41 : trackRow((trackY > trackParam[0]) ? trackY - trackParam[0] : 1); break;  // A : haut
+        case 0x42 : trackRow((trackY + trackParam[0] < 24) ? trackY + trackParam[0] : 24); break;  // B : bas
+        case 0x43 : trackX = (trackX + trackParam[0] < trackColumns) ? trackX + trackParam[0] : trackColumns; break;  // C : droite
+        case 0x44 : trackX = (trackX > trackParam[0]) ? trackX - trackParam[0] : 1; break;  // D : gauche
+        case 0x40 : case 0x4A : case 0x4B : case 0x50 : case 0x68 : case 0x6C :
+          break;  // Effacements, suppressions et insertions de caractères
+        default :
+          invalidateCursor();  // Insertions ou suppressions de rangées, changements de standard...
+      }
+      if (trackY < 1) trackKnown = false;  // Pas de déplacement relatif en rangée 0
+      return;
+    case SUIVI_US :
+      trackState = SUIVI_US2;
+      trackParam[0] = b;
+      return;
+    case SUIVI_US2 :
+      trackState = SUIVI_NORMAL;
+      trackSeparator();
+      if (trackParam[0] >= 0x40 && trackParam[0] <= 0x40 + 24 && b > 0x40 && b <= 0x40 + trackColumns) {
+        trackKnown = true;
+        trackX = b - 0x40;
+        trackY = trackParam[0] - 0x40;
+      }
+      else trackKnown = false;
+      return;
+    case SUIVI_SS2 :
+      // Un diacritique ne fait pas avancer le curseur : il se combine avec la lettre qui suit.
+      trackState = (b >= 0x40 && b <= 0x4F) ? SUIVI_DIACRITIQUE : SUIVI_NORMAL;
+      if (trackState == SUIVI_NORMAL) trackAdvance(1);
+      return;
+    case SUIVI_DIACRITIQUE :
+      trackState = SUIVI_NORMAL;
+      trackAdvance(1);
+      return;
+    case SUIVI_REP :
+      trackState = SUIVI_NORMAL;
+      // Chaque répétition est comptée à part : en double largeur, un
+      // caractère en dernière colonne n'occupe qu'une case.
+      for (int i=0x40; i<b && trackKnown; i++) {
+        trackWidth = trackCharWidth();
+        trackAdvance(1);
+      }
+      return;
+    case SUIVI_PRO :
+      if (--trackCount == 0) trackState = SUIVI_NORMAL;
+      return;
+  }
+  if (b >= SP) {  // Caractère visualisable
+    // En mode texte, l'espace est un délimiteur : il valide les attributs
+    // de zone (voir p.93). En mode graphique, tout caractère en est un.
+    if (b == SP || trackAttr[ATTR_JEU] == SO) {
+      trackZone[0] = trackAttr[ATTR_FOND];
+      trackZone[1] = trackAttr[ATTR_MASQUAGE];
+      trackZone[2] = trackAttr[ATTR_LIGNAGE];
+    }
+    else if (trackAttr[ATTR_JEU] != SI) {
+      trackZone[0] = trackZone[1] = trackZone[2] = 0;
     }
+    trackWidth = trackCharWidth();
+    trackAdvance(1);
+    return;
+  }
+  switch (b) {
+    case ESC : trackState = SUIVI_ESC; break;
+    case US  : trackState = SUIVI_US; break;
+    case SS2 :
+      trackWidth = trackCharWidth();
+      // Caractère G2 en mode graphique : la taille lui est-elle appliquée ?
+      if (trackAttr[ATTR_JEU] == SO && trackAttr[ATTR_TAILLE] != GRANDEUR_NORMALE && trackAttr[ATTR_TAILLE] != DOUBLE_HAUTEUR) trackWidth = 0;
+      trackState = SUIVI_SS2;
+      break;
+    case REP : trackState = SUIVI_REP; break;
+    case SO  :
+    case SI  : trackAttr[ATTR_JEU] = b; break;
+    case RS  :
+    case FF  :
+      trackKnown = true;
+      trackX = 1;
+      trackY = 1;
+      trackSeparator();
+      break;
+    case CR : trackX = 1; break;
+    case CAN :  // Espaces jusqu'au bout de la rangée : ils valident les attributs de zone.
+      trackZone[0] = trackAttr[ATTR_FOND];
+      trackZone[1] = trackAttr[ATTR_MASQUAGE];
+      trackZone[2] = trackAttr[ATTR_LIGNAGE];
+      break;
+    case HT :
+      if (++trackX > trackColumns) {
+        trackX = 1;
+        trackRow(trackY + 1);
+      }
+      break;
+    case BS :
+      if (--trackX < 1) {
+        trackX = trackColumns;
+        trackRow(trackY - 1);
+      }
+      break;
+    case LF : trackRow(trackY + 1); break;
+    case VT : trackRow(trackY - 1); break;
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::trackAdvance(int n) {
+  // Le curseur avance de n caractères de la largeur du dernier visualisé
+  // et passe au début de la rangée suivante en bout de rangée.
+  if (!trackKnown) return;
+  if (trackWidth == 0) {  // Largeur inconnue
+    invalidateCursor();
+    return;
+  }
+  trackX += n * trackWidth;
+  while (trackX > trackColumns) {
+    trackX -= trackColumns;
+    trackRow(trackY + 1);
+  }
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::trackRow(int y) {
+  // Changement de rangée sans séparateur : les attributs de zone demandés
+  // ne sont plus connus, ceux validés reprennent leur valeur par défaut
+  // (comme dans MinitelEmulator).
+  trackAttr[ATTR_FOND] = trackAttr[ATTR_MASQUAGE] = trackAttr[ATTR_LIGNAGE] = 0;
+  if (y != trackY) {
+    trackZone[0] = FOND_NOIR;
+    trackZone[1] = DEMASQUAGE;
+    trackZone[2] = FIN_LIGNAGE;
+  }
+  if (trackY == 0) {  // LF en rangée 0 : retour à la position et aux attributs d'avant (inconnus ici)
+    trackKnown = false;
+    invalidateAttributes();
+  }
+  if (y > 24) y = trackScroll ? 24 : 1;  // Défilement en mode rouleau
+  if (y < 1) {
+    if (trackScroll) trackKnown = false;
+    y = 24;
+  }
+  trackY = y;
+}
+/*--------------------------------------------------------------------*/
+
+void Minitel::trackSeparator() {
+  // US, RS et FF : tous les attributs reprennent leur valeur par défaut (voir p.96)
+  for (int i=0; i<8; i++) trackAttr[i] = ATTR_DEFAUT[i];
+  trackZone[0] = FOND_NOIR;
+  trackZone[1] = DEMASQUAGE;
+  trackZone[2] = FIN_LIGNAGE;
+}
+/*--------------------------------------------------------------------*/
+
+byte Minitel::trackCharWidth() {
+  // Largeur du prochain caractère visualisé : 1, 2 ou 0 si inconnue
+  byte taille = trackAttr[ATTR_TAILLE];
+  byte jeu = trackAttr[ATTR_JEU];
+  if (jeu == SO || taille == GRANDEUR_NORMALE || taille == DOUBLE_HAUTEUR) return 1;
+  if (jeu == 0 || taille == 0) return 0;
+  if (trackKnown && trackX == trackColumns) return 1;  // Pas de double largeur en dernière colonne
+  return 2;
+}
+/*--------------------------------------------------------------------*/
+
+boolean Minitel::attributesAtDefault() {
+  for (int i=0; i<8; i++) {
+    if (trackAttr[i] != ATTR_DEFAUT[i]) return false;
   }
-  return (byte) trame;
+  return trackZone[0] == FOND_NOIR && trackZone[1] == DEMASQUAGE && trackZone[2] == FIN_LIGNAGE;
 }
 /*--------------------------------------------------------------------*/
 
 unsigned long Minitel::getCursorXY() {  // Voir p.98
+  int i = reserveRequest();
+  if (i < 0) return 0;
   // Demande
   writeByte(ESC);
   writeByte(0x61);
   // Réponse
-  while (!isListening());  // On attend que le port soit sur écoute.
-  unsigned long trame = 0;  // 32 bits = 4 octets  
-  while (trame >> 16 != US) {
-    if (available() > 0) {
-      trame = (trame << 8) + readByte();
-    }
+  unsigned long trame = waitReply(request(i, REQUETE_CURSEUR, 0, NULL));  // 0 sans réponse
+  if (trame != 0) {
+    // La réponse donne la position exacte du curseur.
+    trackY = ((trame >> 8) & 0xFF) - 0x40;
+    trackX = (trame & 0xFF) - 0x40;
+    trackKnown = true;
   }
   return trame;
 }
 /*--------------------------------------------------------------------*/
+
+
+
+
+////////////////////////////////////////////////////////////////////////
+/*
+   MinitelTranscoder
+*/
+////////////////////////////////////////////////////////////////////////
+
+size_t MinitelTranscoder::transcode(const byte* source, size_t size, byte* destination, size_t capacity, size_t* used) {
+  size_t i = 0;
+  size_t n = 0;
+  while (i < size && n + MAX_CODE <= capacity) {
+    byte b = source[i++];
+    unsigned long unicode;
+    if (b < 0x80) {  // Caractère de 7 bits, le cas le plus fréquent
+      missing = 0;
+      if (b >= SP && b != 0x5E && b != 0x60) destination[n++] = b;  // ^ et ` non visualisables seuls
+      continue;
+    }
+    if (b < 0xC0) {  // Octet de continuation
+      if (missing == 0) continue;  // Isolé : ignoré
+      pending = (pending << 6) | (b & 0x3F);
+      if (--missing > 0) continue;
+      unicode = pending;
+    }
+    else {  // Premier octet d'une séquence de 2 à 4 octets
+      if (b < 0xE0)      { pending = b & 0x1F; missing = 1; }
+      else if (b < 0xF0) { pending = b & 0x0F; missing = 2; }
+      else if (b < 0xF8) { pending = b & 0x07; missing = 3; }
+      else missing = 0;
+      continue;
+    }
+    unsigned long code = videotexCode(unicode);
+    if (code > 0xFFFF) destination[n++] = (byte) (code >> 16);
+    if (code > 0xFF) destination[n++] = (byte) (code >> 8);
+    if (code != 0) destination[n++] = (byte) code;
+  }
+  if (used != NULL) *used = i;
+  return n;
+}
+/*--------------------------------------------------------------------*/
+
+unsigned long MinitelTranscoder::videotexCode(unsigned long unicode) {
+  if (unicode < SP) return 0;
+  if (unicode <= DEL) return (unicode == 0x5E || unicode == 0x60) ? 0 : unicode;
+  if (unicode > 0xFFFF) return 0;
+  // Recherche par dichotomie
+  byte debut = 0;
+  byte fin = NB_CARACTERES_VIDEOTEX;
+  while (debut < fin) {
+    byte milieu = (debut + fin) / 2;
+    uint16_t u = pgm_read_word(&CARACTERES_VIDEOTEX[milieu].unicode);
+    if (u == unicode) return pgm_read_dword(&CARACTERES_VIDEOTEX[milieu].videotex);
+    if (u < unicode) debut = milieu + 1;
+    else fin = milieu;
+  }
+  return 0;  // Supposé non visualisable
+}
+/*--------------------------------------------------------------------*/
+
+unsigned long MinitelTranscoder::unicodeCode(unsigned long videotex) {
+  // Les codes émis par le clavier pour les caractères des jeux G2 et les
+  // lettres accentuées sont ceux qu'on envoie pour les afficher.
+  if ((videotex >> 8) == SI) return 0;  // Plusieurs caractères pour un même code
+  for (byte i=0; i<NB_CARACTERES_VIDEOTEX; i++) {
+    if (pgm_read_dword(&CARACTERES_VIDEOTEX[i].videotex) == videotex) {
+      return pgm_read_word(&CARACTERES_VIDEOTEX[i].unicode);
+    }
+  }
+  return 0;
+}
+/*--------------------------------------------------------------------*/
+
+boolean MinitelTranscoder::isVisualisable(unsigned long unicode) {
+  // Fonction proposée par iodeo sur GitHub en février 2023 (Minitel::isVisualisable)
+  // Teste la conversion d'un code brut clavier en équivalent Unicode
+  // Voir https://iodeo.github.io/MinitelKeyboardHelper/
+  // Les caractères de contrôle ne sont pas visualisables
+  if (unicode < SP) return false;
+  // Les autres caractères de 7 bits sont visualisables
+  if (unicode <= DEL) return true;
+  if (unicode < 0xA0) return false;
+  if (unicode <= 0xFF) {
+    byte k = unicode - 0xA0;
+    return (pgm_read_byte(VISUALISABLES_LATIN1 + k / 8) >> (k % 8)) & 1;
+  }
+  return videotexCode(unicode) != 0;  // Au-delà, seuls les caractères de la table
+}
+/*--------------------------------------------------------------------*/
+
+
+
+
+////////////////////////////////////////////////////////////////////////
+/*
+   MinitelPackedPage
+*/
+////////////////////////////////////////////////////////////////////////
+
+boolean MinitelPackedPage::begin(const byte* page, size_t size) {
+  return start(page, size, false);
+}
+/*--------------------------------------------------------------------*/
+
+boolean MinitelPackedPage::begin_P(const byte* page, size_t size) {
+  return start(page, size, true);
+}
+/*--------------------------------------------------------------------*/
+
+size_t MinitelPackedPage::read(byte* destination, size_t capacity) {
+  size_t n = 0;
+  while (n < capacity) {
+    if (copy > 0) {  // La copie peut recouvrir ce qu'elle produit (suite d'octets identiques).
+      byte b = window[(byte) (position - distance)];
+      window[position++] = b;
+      destination[n++] = b;
+      copy--;
+      continue;
+    }
+    if (offset >= size) break;
+    byte code = next();
+    if (code < 0x80) {
+      window[position++] = code;
+      destination[n++] = code;
+    }
+    else if (code < 0xC0) {
+      if (offset >= size) break;  // Page tronquée
+      copy = (code & 0x3F) + 3;
+      distance = next() + 1;
+    }
+    else {
+      copy = ((code >> 4) & 0b11) + 2;
+      distance = (code & 0x0F) + 1;
+    }
+  }
+  return n;
+}
+/*--------------------------------------------------------------------*/
+
+boolean MinitelPackedPage::start(const byte* page, size_t size, boolean flash) {
+  this->data = page;
+  this->size = size;
+  this->flash = flash;
+  offset = 0;
+  total = 0;
+  position = 0;
+  copy = 0;
+  if (size < 3 || next() != 'V') {
+    this->size = 0;  // read ne produira rien
+    return false;
+  }
+  total = next();
+  total |= (size_t) next() << 8;
+  return true;
+}
+/*--------------------------------------------------------------------*/
+
+#if !defined(ARDUINO)
+std::vector<byte> MinitelPackedPage::pack(const byte* page, size_t size) {
+  // Découpage optimal : cout[i] est la taille minimale du codage des
+  // octets i et suivants. Une page fait au plus quelques milliers
+  // d'octets : la recherche exhaustive dans la fenêtre reste rapide.
+  std::vector<byte> resultat;
+  if (size > 0xFFFF) return resultat;
+  std::vector<size_t> cout(size + 1, 0);
+  std::vector<word> choixLongueur(size, 1);  // 1 : octet seul
+  std::vector<word> choixDistance(size, 0);
+  for (size_t i=size; i-- > 0;) {
+    cout[i] = 1 + cout[i+1];
+    for (size_t d=1; d<=256 && d<=i; d++) {
+      size_t longueur = 0;
+      while (longueur < 66 && i + longueur < size
+             && (page[i+longueur] & 0x7F) == (page[i+longueur-d] & 0x7F)) {
+        longueur++;
+      }
+      for (size_t l=2; l<=longueur; l++) {
+        size_t c;
+        if (l <= 5 && d <= 16) c = 1;
+        else if (l >= 3) c = 2;
+        else continue;
+        if (c + cout[i+l] < cout[i]) {
+          cout[i] = c + cout[i+l];
+          choixLongueur[i] = l;
+          choixDistance[i] = d;
+        }
+      }
+    }
+  }
+  resultat.push_back('V');
+  resultat.push_back(size & 0xFF);
+  resultat.push_back(size >> 8);
+  size_t i = 0;
+  while (i < size) {
+    size_t l = choixLongueur[i];
+    size_t d = choixDistance[i];
+    if (l == 1) {
+      resultat.push_back(page[i] & 0x7F);
+    }
+    else if (l <= 5 && d <= 16) {
+      resultat.push_back(0xC0 | ((l - 2) << 4) | (d - 1));
+    }
+    else {
+      resultat.push_back(0x80 | (l - 3));
+      resultat.push_back(d - 1);
+    }
+    i += l;
+  }
+  return resultat;
+}
+#endif
+/*--------------------------------------------------------------------*/
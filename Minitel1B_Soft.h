@@ -34,11 +34,18 @@
 // Selon la version d'Arduino
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "Arduino.h"
-#else
+#elif defined(ARDUINO)
 #include "WProgram.h"
+#else
+#include "Minitel1B_Host.h"  // Compilation native (Linux) : voir Minitel1B_Host.h
 #endif  // Fin Si (ARDUINO)
 
+#if defined(ARDUINO)
 #include "SoftwareSerial.h"
+typedef SoftwareSerial MinitelSerial;  // Sous Linux, MinitelSerial est défini dans Minitel1B_Host.h
+#elif defined(MINITEL_STATS)
+#include <stdio.h>  // printStats
+#endif  // Fin Si (ARDUINO)
 
 ////////////////////////////////////////////////////////////////////////
 
@@ -251,6 +258,130 @@
 
 
 
+// Tampon d'émission (voir writeBytes, flush et setAutoFlush)
+// Sa taille peut être modifiée en définissant MINITEL_TX_BUFFER_SIZE
+// avant d'inclure Minitel1B_Soft.h.
+#ifndef MINITEL_TX_BUFFER_SIZE
+#if defined(ARDUINO)
+#define MINITEL_TX_BUFFER_SIZE  32    // La mémoire vive est comptée sur un ATMega 328P
+#else
+#define MINITEL_TX_BUFFER_SIZE  1024
+#endif
+#endif
+
+// Envoi des pages pré-calculées (voir beginPage et streamPage) : nombre
+// maximum d'octets envoyés à chaque appel de streamPage.
+#ifndef MINITEL_PAGE_CHUNK
+#if defined(ARDUINO)
+#define MINITEL_PAGE_CHUNK  32
+#else
+#define MINITEL_PAGE_CHUNK  1024
+#endif
+#endif
+
+
+
+
+// Réponses du Minitel (voir poll, replyStatus et replyValue)
+#define REPONSE_ATTENTE   0
+#define REPONSE_RECUE     1
+#define REPONSE_ECHEC    -1  // Délai dépassé ou requête inconnue
+// Nombre de requêtes en attente simultanément, nombre de touches gardées
+// en attente de lecture et délai au-delà duquel une séquence reçue incomplète
+// (touche Esc seule par exemple) est considérée comme terminée.
+#ifndef MINITEL_MAX_REQUESTS
+#if defined(ARDUINO)
+#define MINITEL_MAX_REQUESTS  2
+#else
+#define MINITEL_MAX_REQUESTS  8
+#endif
+#endif
+#ifndef MINITEL_KEY_EVENTS
+#if defined(ARDUINO)
+#define MINITEL_KEY_EVENTS  4
+#else
+#define MINITEL_KEY_EVENTS  32
+#endif
+#endif
+#define MINITEL_INTER_BYTE_TIMEOUT  50  // En ms (un octet dure 33 ms à 300 bauds)
+
+// Fonction appelée à l'arrivée de la réponse ou à l'expiration du délai
+typedef void (*MinitelCallback)(int requete, int statut, unsigned long reponse);
+
+// Touche décodée (voir readKey)
+struct MinitelKeyEvent
+{
+  unsigned long code;     // Code brut émis par le clavier (0x1341 pour ENVOI...)
+  unsigned long unicode;  // Conversion unicode si applicable, sinon code
+  unsigned long time;     // millis() quand poll() a reçu la touche
+};
+
+// Qualité de la ligne et vitesse adaptative (voir lineStats) : comme
+// MINITEL_STATS ci-dessous, la bibliothèque entière doit être compilée avec
+// MINITEL_LINE_STATS défini. Sans lui, rien n'est compté (environ 100
+// octets de mémoire vive économisés).
+#if defined(MINITEL_LINE_STATS)
+// Qualité de la ligne à une vitesse donnée
+struct MinitelLineStats
+{
+  unsigned long received;      // Octets reçus
+  unsigned long parityErrors;  // Octets reçus avec une erreur de parité
+  unsigned long resyncs;       // Trames du protocole perdues (interrompues ou altérées)
+  unsigned long replies;       // Réponses reçues
+  unsigned long timeouts;      // Réponses attendues en vain
+};
+#endif
+
+// Instrumentation (voir stats) : la bibliothèque entière doit être compilée
+// avec MINITEL_STATS défini (option -DMINITEL_STATS, build_flags de
+// PlatformIO...). Sans lui, rien n'est compté et rien n'est ajouté.
+#if defined(MINITEL_STATS)
+// Catégories des octets émis
+#define STATS_CURSEUR    0  // Déplacements du curseur et effacements (BS, US, CSI...)
+#define STATS_ATTRIBUTS  1  // Attributs de visualisation, SO et SI
+#define STATS_TEXTE      2  // Caractères des jeux G0 et G2 (et leurs REP)
+#define STATS_MOSAIQUE   3  // Caractères semi-graphiques du jeu G1 (et leurs REP)
+#define STATS_PROTOCOLE  4  // Séquences PRO et autres commandes
+#define STATS_CATEGORIES 5
+// Familles de fonctions (l'appel le plus extérieur compte seul)
+#define STATS_APPEL_CURSEUR      0  // newXY, moveCursorXY, moveCursorLeft...
+#define STATS_APPEL_ATTRIBUTS    1  // attributs, textMode, graphicMode
+#define STATS_APPEL_TEXTE        2  // print, println, printChar, printChars, printSpecialChar
+#define STATS_APPEL_GRAPHIC      3  // graphic, repeat
+#define STATS_APPEL_GEOMETRIE    4  // rect, panel, fillRect, clearRect, hLine, vLine
+#define STATS_APPEL_EFFACEMENTS  5  // newScreen, cancel, clearScreen..., deleteChars...
+#define STATS_APPEL_PAGE         6  // streamPage
+#define STATS_APPELS             7
+// Requêtes chronométrées
+#define STATS_IDENTIFICATION  0  // identifyDevice
+#define STATS_VITESSE         1  // changeSpeed, currentSpeed (pas searchSpeed)
+#define STATS_POSITION        2  // getCursorXY
+#define STATS_REQUETES        3
+
+// Temps de réponse du Minitel à un type de requête, en ms
+struct MinitelLatency
+{
+  unsigned long replies;   // Réponses reçues
+  unsigned long timeouts;  // Réponses attendues en vain
+  unsigned long fastest;
+  unsigned long slowest;
+  unsigned long total;     // Somme (moyenne : total / replies)
+};
+
+struct MinitelStats
+{
+  unsigned long sent[STATS_CATEGORIES];  // Octets émis par catégorie
+  unsigned long received;                // Octets reçus...
+  unsigned long replyBytes;              // ...dont réponses aux requêtes
+  unsigned long calls[STATS_APPELS];     // Appels par famille de fonctions
+  unsigned long callBytes[STATS_APPELS]; // Octets émis par ces appels
+  MinitelLatency latency[STATS_REQUETES];
+};
+#endif
+
+
+
+
 // Constantes personnelles pour hline et vline
 #define CENTER  0
 #define TOP     1
@@ -265,19 +396,150 @@
 
 ////////////////////////////////////////////////////////////////////////
 
-class Minitel : public SoftwareSerial
+// Conversion UTF-8 => codes Minitel (jeux G0 et G2, voir p.90), par blocs.
+// Une séquence UTF-8 coupée en fin de bloc est complétée au bloc suivant.
+// Les caractères non visualisables sont ignorés.
+class MinitelTranscoder
+{
+public:
+  static const size_t MAX_CODE = 3;  // Octets Minitel par caractère au plus (SS2, accent, lettre)
+
+  MinitelTranscoder() : pending(0), missing(0) {}
+  // Convertit au plus size octets de source. S'arrête avant que destination
+  // (capacity octets) ne déborde. Renvoie le nombre d'octets écrits dans
+  // destination ; used reçoit le nombre d'octets de source lus.
+  size_t transcode(const byte* source, size_t size, byte* destination, size_t capacity, size_t* used = NULL);
+  boolean inSequence() const { return missing != 0; }  // Séquence UTF-8 commencée mais incomplète
+  void reset() { missing = 0; }
+
+  static unsigned long videotexCode(unsigned long unicode);  // Unicode => Code Minitel (à envoyer avec writeCode), 0 si non visualisable
+  static unsigned long unicodeCode(unsigned long videotex);  // Code Minitel ou code du clavier => Unicode, 0 si inconnu
+  static boolean isVisualisable(unsigned long unicode);
+
+private:
+  unsigned long pending;  // Bits déjà lus du caractère en cours
+  byte missing;  // Octets de continuation attendus
+};
+
+////////////////////////////////////////////////////////////////////////
+
+// Page Vidéotex compressée (voir extras/Linux/Compresseur_Pages.cpp),
+// décompressée au fil de l'envoi (voir Minitel::beginPage) : seule une
+// fenêtre des 256 derniers octets est gardée en mémoire vive.
+// Format : 'V', taille décompressée (2 octets, poids faible d'abord), puis
+//   0xxxxxxx          : octet x (7 bits, la parité est recalculée à l'envoi)
+//   10LLLLLL dddddddd : copie de L+3 octets (3 à 66) situés d+1 octets plus tôt (1 à 256)
+//   11LLDDDD          : copie de L+2 octets (2 à 5) situés D+1 octets plus tôt (1 à 16)
+class MinitelPackedPage
+{
+public:
+  MinitelPackedPage() : data(NULL), size(0), offset(0), flash(false), total(0), position(0), copy(0), distance(0) {}
+  boolean begin(const byte* page, size_t size);  // Page en mémoire vive. false si ce n'est pas une page compressée.
+  boolean begin_P(const byte* page, size_t size);  // Page en mémoire flash (PROGMEM)
+  size_t length() const { return total; }  // Taille décompressée
+  size_t read(byte* destination, size_t capacity);  // Décompresse la suite : renvoie le nombre d'octets écrits, 0 à la fin
+#if !defined(ARDUINO)
+  static std::vector<byte> pack(const byte* page, size_t size);  // Compression (vide si la page dépasse 65535 octets)
+#endif
+
+private:
+  const byte* data;
+  size_t size;
+  size_t offset;  // Prochain octet de data à lire
+  boolean flash;
+  size_t total;
+  byte window[256];  // Derniers octets produits
+  byte position;  // Prochaine case de window (le débordement fait le tour)
+  byte copy;  // Octets restant à copier
+  word distance;
+  byte next() { return flash ? pgm_read_byte(data + offset++) : data[offset++]; }
+  boolean start(const byte* page, size_t size, boolean flash);
+};
+
+////////////////////////////////////////////////////////////////////////
+
+class Minitel : public MinitelSerial
 {
 public:
+#if defined(ARDUINO)
   Minitel(int rx, int tx);
+#else
+  Minitel(MinitelTransport& transport);  // Port série réel, pseudo-terminal, fichier ou mémoire
+  ~Minitel();
+#endif
   
   // Ecrire un octet, un mot ou un code de 4 octets maximum / Lire un octet
   void writeByte(byte b);
   void writeWord(word w);
   void writeCode(unsigned long code);  // 4 octets maximum
+  void writeBytes(const byte* buffer, size_t size);  // Plusieurs octets d'un coup
   byte readByte();
+
+  // Parité paire sur 7 bits appliquée à tout un bloc d'octets (pages pré-calculées...)
+  static void encodeParity(const byte* source, byte* destination, size_t size);
+  static size_t decodeParity(const byte* source, byte* destination, size_t size);  // Renvoie le nombre d'erreurs
+
+  // Parité gérée par le port série (7 bits, parité paire, 1 stop) plutôt que par la bibliothèque.
+  // Possible sous Linux (termios), pas avec SoftwareSerial qui ne connaît que le format 8N1 :
+  // renvoie false si le port ne sait pas le faire (la parité reste alors logicielle).
+  // Les octets reçus avec une erreur de parité sont écartés et comptés, au lieu d'être lus 0xFF.
+  bool setNativeParity(bool actif);
+  unsigned long parityErrors();  // Nombre d'erreurs de parité constatées en réception
+
+  // Tampon d'émission
+  // Les octets sont d'abord placés dans un tampon puis envoyés en une
+  // seule fois sur la ligne. Par défaut (seuil de 1), chaque fonction de
+  // la bibliothèque envoie ce qu'elle a produit avant de rendre la main,
+  // comme auparavant. Avec un seuil plus grand, on compose un écran
+  // entier avant de l'envoyer d'un bloc avec flush().
+  // Le tampon est toujours vidé avant d'attendre une réponse du Minitel.
+  void flush();  // Envoie immédiatement le contenu du tampon
+  void setAutoFlush(size_t seuil);  // Envoi automatique dès que le tampon contient seuil octets
+  size_t pendingBytes();  // Nombre d'octets en attente dans le tampon
+  void holdFlush();  // Diffère l'envoi automatique...
+  void releaseFlush();  // ...jusqu'à l'appel correspondant (les appels peuvent être imbriqués)
+
+  // Répétition automatique
+  // Une suite de caractères identiques envoyés à la suite (par print,
+  // graphic, writeBytes...) est codée par REP dès que c'est plus court.
+  // La suite n'est close qu'à l'octet suivant ou à l'envoi du tampon :
+  // avec le seuil d'envoi par défaut, seuls les caractères émis par une
+  // même fonction (ou entre holdFlush et releaseFlush) sont regroupés.
+  void setAutoRepeat(boolean actif);  // Activée par défaut
+
+  // Pages Vidéotex pré-calculées (voir https://github.com/eserandour/Conversion_Videotex_Hex)
+  // La page part telle quelle (sans REP automatique), par blocs : on appelle
+  // streamPage() dans loop() tant qu'elle renvoie true, le reste du
+  // programme continue de tourner entre deux blocs. Avec le rythme activé,
+  // chaque appel n'envoie que ce que la ligne a pu écouler depuis l'appel
+  // précédent à la vitesse en cours.
+  void beginPage(const byte* page, size_t size);  // Page en mémoire vive
+  void beginPage_P(const byte* page, size_t size);  // Page en mémoire flash (PROGMEM)
+#if defined(ARDUINO)
+  void beginPage(Stream& fichier);  // Fichier (SD, LittleFS...) lu jusqu'à la fin
+#else
+  bool beginPage(const char* fichier);  // Fichier .vdt projeté en mémoire (false s'il ne peut être lu)
+#endif
+  void beginPage(MinitelPackedPage& page);  // Page compressée, préparée par begin ou begin_P
+  boolean streamPage();  // Envoie le bloc suivant. false : page terminée (ou aucune page en cours)
+  void endPage();  // Abandonne la page en cours
+  size_t pageProgress();  // Octets déjà envoyés
+  size_t pageLength();  // Taille de la page
+  void setPagePacing(boolean actif);  // Désactivé par défaut
+  // Priorités pendant l'envoi d'une page : l'écho du clavier et la ligne
+  // d'état passent devant la suite de la page, qui reprend ensuite à la
+  // même position avec les mêmes attributs. Avec le rythme activé, ils n'ont
+  // jamais plus de setPageLatency ms de page en attente devant eux.
+  // beginPage pendant l'envoi d'une page remplace celle-ci.
+  void setPageLatency(unsigned long ms);  // 50 ms par défaut
+  void beginOverlay();  // Ce qui est écrit ensuite (écho...) passe avant la suite de la page
+  void endOverlay();  // Retour à la position et aux attributs d'avant beginOverlay, envoi immédiat
+  void setStatus(const char* texte);  // Texte de la rangée 0, envoyé par streamPage avant la suite de la page. Un texte remplacé avant d'être envoyé est abandonné. Il n'est pas copié.
+  void setPageCancelKeys(boolean actif);  // streamPage abandonne la page à l'appui sur ANNULATION, RETOUR ou SOMMAIRE (la touche reste à lire). Désactivé par défaut.
   
   // Identification du type de Minitel
   unsigned long identifyDevice();
+  int identifyDeviceAsync(MinitelCallback callback = NULL);
   
   // Vitesse de la liaison série
   // A la mise sous tension du Minitel, la vitesse des échanges entre
@@ -292,8 +554,41 @@ public:
   // Attention ! Si le Minitel et le périphérique ne communiquent pas
   // à la même vitesse, on perd la liaison.
   int changeSpeed(int bauds);  // A tout moment, un périphérique peut modifier les vitesses d'échange de la prise (vitesses possibles : 300, 1200, 4800 bauds ; également 9600 bauds pour le Minitel 2).
+  int changeSpeedAsync(int bauds, MinitelCallback callback = NULL);  // Réponse en bauds, 0 si inconnue
   int currentSpeed();  // Pour connaitre la vitesse d'échange en cours, le Minitel et le périphérique échangeant à la même vitesse.
-  int searchSpeed();  // Pour connaitre la vitesse du Minitel, le Minitel et le périphérique n'échangeant pas nécessairement à la même vitesse.
+  int currentSpeedAsync(MinitelCallback callback = NULL);
+  int searchSpeed();  // Pour connaitre la vitesse du Minitel, le Minitel et le périphérique n'échangeant pas nécessairement à la même vitesse. -1 si le Minitel ne répond à aucune.
+  int negotiateSpeed(int maximum = 9600);  // searchSpeed, puis passage à la vitesse la plus rapide du modèle identifié (sans dépasser maximum). -1 sans réponse.
+  // La vitesse trouvée est essayée en premier à la recherche suivante, même
+  // après un redémarrage si elle est mémorisée :
+#if defined(ARDUINO)
+  void setSpeedCache(int adresse);  // Octet de l'EEPROM (cartes AVR seulement), -1 par défaut : non mémorisée
+#else
+  void setSpeedCache(const char* fichier);  // Fichier texte, NULL par défaut : non mémorisée
+#endif
+#if defined(MINITEL_LINE_STATS)
+  // Qualité de la ligne, comptée par poll() pour chaque vitesse (300, 1200,
+  // 4800 et 9600 bauds). adaptSpeed, appelée de temps en temps quand rien
+  // n'est en cours d'envoi, monte d'un cran quand la ligne est propre depuis
+  // un moment et redescend quand les erreurs se multiplient (un câble long
+  // reste fiable, un câble court profite de 4800 ou 9600 bauds).
+  MinitelLineStats lineStats(int bauds = 0);  // 0 : vitesse en cours
+  void resetLineStats();
+  int adaptSpeed(int maximum = 9600);  // Renvoie la vitesse en cours, -1 si le Minitel ne répond plus
+#endif
+#if defined(MINITEL_STATS)
+  // Instrumentation (voir MINITEL_STATS) : octets émis par catégorie et
+  // par famille de fonctions, leur durée sur la ligne à la vitesse en
+  // cours et les temps de réponse du Minitel.
+  const MinitelStats& stats() { return statsData; }
+  void resetStats();
+  unsigned long wireTime(unsigned long octets);  // Durée de l'envoi en ms à la vitesse en cours
+#if defined(ARDUINO)
+  void printStats(Print& sortie = Serial);  // Tableau lisible, sur le port série de débogage par défaut
+#else
+  void printStats(FILE* sortie = stdout);
+#endif
+#endif
   
   // Séparateurs
   void newScreen();  // Attention ! newScreen réinitialise les attributs de visualisation.
@@ -302,14 +597,23 @@ public:
   // Curseur
   void cursor();  // Curseur visible
   void noCursor();  // Curseur invisible
-  void moveCursorXY(int x, int y);  // Adressage direct du curseur en colonne x et rangée y.
+  void moveCursorXY(int x, int y);  // Curseur en colonne x et rangée y, par le plus court chemin (voir plus bas).
   void moveCursorLeft(int n);  // Curseur vers la gauche de n colonnes. Arrêt au bord gauche de l'écran.
   void moveCursorRight(int n);  // Curseur vers la droite de n colonnes. Arrêt au bord droit de l'écran.
   void moveCursorDown(int n);  // Curseur vers le bas de n rangées. Arrêt en bas de l'écran.
   void moveCursorUp(int n);  // Curseur vers le haut de n rangées. Arrêt en haut de l'écran.
   void moveCursorReturn(int n);  // Retour du curseur au début de la rangée courante puis curseur vers le bas de n rangées. Arrêt en bas de l'écran.
-  int getCursorX();  // Colonne où se trouve le curseur
-  int getCursorY();  // Rangée où se trouve le curseur
+  int getCursorX();  // Colonne où se trouve le curseur (-1 sans réponse)
+  int getCursorY();  // Rangée où se trouve le curseur (-1 sans réponse)
+  // Suivi local du curseur
+  // La bibliothèque observe tous les octets qu'elle émet et en déduit la
+  // position du curseur. moveCursorXY choisit alors le déplacement le
+  // moins coûteux (CR, LF, BS, HT, VT, CSI relatif ou CSI absolu) au lieu
+  // d'envoyer systématiquement CSI Pr ; Pc H. Tant que la position est
+  // inconnue (mise sous tension, touche lue avec l'écho actif, octets
+  // envoyés par write() qui échappent au suivi...), l'adressage est absolu.
+  void invalidateCursor();  // A appeler si le curseur a pu bouger à l'insu de la bibliothèque
+  void invalidateAttributes();  // Idem pour les attributs de visualisation
   
   // Effacements, Suppressions, Insertions
   void cancel();  // Remplissage à partir de la position courante du curseur et jusqu'à la fin de la rangée par des espaces du jeu courant ayant l'état courant des attributs. Le position courante du curseur n'est pas déplacée.
@@ -330,65 +634,247 @@ public:
   void textMode();      // Accès au jeu G0 - Mode Vidéotex 40 colonnes (par défaut à la mise sous tension du Minitel)
   void graphicMode();   // Accès au jeu G1 - Mode Vidéotex 40 colonnes
   byte pageMode();      // Mode page
+  int pageModeAsync(MinitelCallback callback = NULL);
   byte scrollMode();    // Mode rouleau
+  int scrollModeAsync(MinitelCallback callback = NULL);
   byte modeMixte();     // Mode Vidéotex => Mode Mixte 80 colonnes (Aucun caractère semi-graphique (jeu G1) n'est visualisable)
+  int modeMixteAsync(MinitelCallback callback = NULL);
   byte modeVideotex();  // Mode Mixte => Mode Vidéotex 40 colonnes
+  int modeVideotexAsync(MinitelCallback callback = NULL);
 
   // Standards
   byte standardTeleinformatique();  // Standard Télétel => Standard Téléinformatique 80 colonnes (Possibilités de programmation moins étendues)
+  int standardTeleinformatiqueAsync(MinitelCallback callback = NULL);
   byte standardTeletel();           // Standard Téléinformatique => Standard Télétel (inclut les modes Vidéotex et Mixte)
+  int standardTeletelAsync(MinitelCallback callback = NULL);
 
   // Contenu
+  // Les attributs émis sont suivis comme le curseur : attributs, textMode
+  // et graphicMode n'envoient rien si l'attribut demandé est déjà en
+  // vigueur. US, RS et FF remettent tous les attributs à leur valeur par
+  // défaut ; un changement de rangée rend inconnus le fond, le masquage et
+  // le lignage (attributs de zone, voir p.93).
   void attributs(byte attribut);
-  void print(String chaine);  // UTF-8 => Codes Minitel
-  void println(String chaine);
+  void print(const String& chaine);  // UTF-8 => Codes Minitel
+  void print(const char* chaine);  // Sans passer par un String
+  void print(const char* chaine, size_t size);  // size octets, même s'ils contiennent 0
+  void print(const __FlashStringHelper* chaine);  // print(F("...")) : texte lu directement en mémoire flash
+#if !defined(ARDUINO) && __cplusplus >= 201703L
+  void print(std::string_view chaine);
+  void print(const std::string& chaine) { print(std::string_view(chaine)); }
+#endif
+  unsigned long getVideotexCode(const String& chaine, unsigned int& index);  // Caractère UTF-8 en position index => Code Minitel (0 si non visualisable). index passe au caractère suivant.
+  void println(const String& chaine);
+  void println(const char* chaine);
+  void println(const __FlashStringHelper* chaine);
   void println();
   void printChar(char caractere);  // Caractère du jeu G0 exceptés ceux codés 0x60, 0x7E, 0x7F.
+  void printChars(const char* caracteres, size_t size);  // printChar pour chacun des size caractères, en un seul bloc.
   // void printDiacriticChar(unsigned char caractere);  // Caractère avec accent, tréma ou cédille.  // Obsolète depuis le 26/02/2023
   void printSpecialChar(byte b);  // Caractère du jeu G2. Voir plus haut, au niveau de 1.2.3, les constantes possibles.
-  byte getCharByte(char caractere);
+  byte getCharByte(char caractere);  // 0xFF si le caractère n'est pas dans le jeu G0 (voir printChar)
   String getString(unsigned long code);  // Unicode => UTF-8
   int getNbBytes(unsigned long code);  // À utiliser en association avec getString(unsigned long code) juste ci-dessus.
   void graphic(byte b, int x, int y);  // Jeu G1. Voir page 101. Sous la forme 0b000000 à 0b111111 en allant du coin supérieur gauche au coin inférieur droit. En colonne x et rangée y.
   void graphic(byte b);  // Voir la ligne ci-dessus.
+  static byte getGraphicByte(byte b);  // 0b000000 à 0b111111 => Code du jeu G1 (voir graphic ci-dessus)
   void repeat(int n);  // Permet de répéter le dernier caractère visualisé avec les attributs courants de la position active d'écriture.
   void bip();  // Bip sonore
   
   // Géométrie
-  void rect(int x1, int y1, int x2, int y2);  // Rectangle défini par 2 points.
+  // Chaque figure est tracée d'un bloc, avec les attributs courants, en
+  // choisissant l'ordre de tracé et les déplacements les plus courts.
+  void rect(int x1, int y1, int x2, int y2);  // Rectangle défini par 2 points. Le curseur finit en x1,y1.
+  void panel(int x1, int y1, int x2, int y2, const char* titre = NULL);  // Rectangle à l'intérieur rempli d'espaces (fond courant), titre centré sur le bord supérieur.
+  void fillRect(int x1, int y1, int x2, int y2);  // Espaces avec les attributs courants (FOND_BLEU par exemple).
+  void clearRect(int x1, int y1, int x2, int y2);  // Cases vides. Attention ! Les attributs peuvent reprendre leur valeur par défaut.
   void hLine(int x1, int y, int x2, int position);  // Ligne horizontale. position = TOP, CENTER ou BOTTOM.
   void vLine(int x, int y1, int y2, int position, int sens);  // Ligne verticale. position = LEFT, CENTER ou RIGHT. sens = DOWN ou UP.
   
   // Clavier
-  unsigned long getKeyCode(bool unicode = true);  // Codes Minitel => Unicode par défaut (si false : pas de conversion)
+  // Les octets reçus sont décodés au fil de l'eau par poll() : getKeyCode
+  // et readKey ne bloquent jamais et renvoient les touches dans l'ordre.
+  unsigned long getKeyCode(bool unicode = true);  // Codes Minitel => Unicode par défaut (si false : pas de conversion). 0 si aucune touche.
+  int keyAvailable();  // Nombre de touches décodées en attente
+  boolean readKey(MinitelKeyEvent& touche);  // false si aucune touche
   byte smallMode();  // Mode minuscules du clavier
+  int smallModeAsync(MinitelCallback callback = NULL);
   byte capitalMode();  // Mode majuscules du clavier
+  int capitalModeAsync(MinitelCallback callback = NULL);
   byte extendedKeyboard();  // Clavier étendu
+  int extendedKeyboardAsync(MinitelCallback callback = NULL);
   byte standardKeyboard();  // Clavier standard
+  int standardKeyboardAsync(MinitelCallback callback = NULL);
   byte echo(boolean commande);  // Active ou désactive l'écho à l'écran de ce qui est tapé au clavier
+  int echoAsync(boolean commande, MinitelCallback callback = NULL);
   
   // Protocole
+  // Les commandes qui attendent une réponse du Minitel abandonnent au bout
+  // d'un délai (1 s par défaut, voir setReplyTimeout) et renvoient alors 0
+  // (-1 pour les vitesses). Leur version Async envoie la commande et rend
+  // la main aussitôt : elle renvoie un numéro de requête (-1, sans rien
+  // envoyer, si trop de requêtes sont en attente). La réponse est traitée
+  // par poll(), à appeler régulièrement, puis transmise au callback s'il y
+  // en a un, sinon lue avec replyStatus et replyValue. Une requête terminée
+  // dont la valeur n'a pas été lue cède sa place à une nouvelle requête.
+  void poll();  // Lit les octets reçus : réponses aux requêtes et octets du clavier (lus ensuite par getKeyCode)
+  int replyStatus(int requete);  // REPONSE_ATTENTE, REPONSE_RECUE ou REPONSE_ECHEC
+  unsigned long replyValue(int requete);  // Valeur reçue (0 si échec). Libère la requête qui n'est plus en attente.
+  void setReplyTimeout(unsigned long ms);
   byte aiguillage(boolean commande, byte emetteur, byte recepteur);
+  int aiguillageAsync(boolean commande, byte emetteur, byte recepteur, MinitelCallback callback = NULL);
   byte statusAiguillage(byte module);
+  int statusAiguillageAsync(byte module, MinitelCallback callback = NULL);
   byte connexion(boolean commande);
+  int connexionAsync(boolean commande, MinitelCallback callback = NULL);
   byte reset();
+  int resetAsync(MinitelCallback callback = NULL);
 
 private: 
-  byte currentSize = GRANDEUR_NORMALE;
+  boolean nativeParity = false;
+  unsigned long parityErrorCount = 0;
+
+  // Tampon d'émission circulaire
+  byte txBuffer[MINITEL_TX_BUFFER_SIZE];
+  size_t txStart = 0;  // Position du premier octet en attente
+  size_t txCount = 0;  // Nombre d'octets en attente
+  size_t txThreshold = 1;  // Seuil d'envoi automatique
+  byte txHold = 0;  // > 0 : envoi automatique différé jusqu'à la fin de la fonction en cours
+  void sendByte(byte b);
+  void sendBytes(const byte* buffer, size_t size);
+  void bufferByte(byte b);
+  long lineSpeed = 1200;  // Vitesse de la liaison série en bauds
+#if defined(ARDUINO)
+  int speedCacheAddress = -1;
+#else
+  std::string speedCacheFile;
+#endif
+  int readSpeedCache();
+  void writeSpeedCache(int bauds);
+  int speedCeiling = 0;  // Vitesse la plus rapide du modèle, 0 si inconnue
+  boolean speedProbing = false;  // searchSpeed en cours : les vitesses essayées en vain ne sont pas comptées
+#if defined(MINITEL_LINE_STATS)
+  MinitelLineStats lineCounters[4] = {};  // 300, 1200, 4800 et 9600 bauds
+  unsigned long lineParity = 0;  // parityErrors() déjà répartis
+  MinitelLineStats adaptStart = {};  // Compteurs au début de la période observée par adaptSpeed
+  unsigned long adaptTime = 0;  // Début de cette période
+  long adaptSpeedValue = 0;  // Vitesse observée
+  byte adaptFallbacks = 0;  // Replis successifs : l'attente avant de remonter double à chaque fois
+  MinitelLineStats* lineCounter();
+#endif
+#if defined(MINITEL_STATS)
+  MinitelStats statsData = {};
+  unsigned long statsTotal = 0;  // Octets émis, toutes catégories
+  byte statsLast = STATS_TEXTE;  // Catégorie du dernier caractère visualisé (pour REP)
+  byte statsDepth = 0;  // Appels imbriqués (voir StatsCall)
+  void statsByte(byte b);
+  void statsReply(byte type, int statut, unsigned long debut);
+  struct StatsCall {  // Compte l'appel en cours s'il est le plus extérieur (voir COMPTER_APPEL)
+    StatsCall(Minitel* minitel, byte famille);
+    ~StatsCall();
+    Minitel* minitel;
+    byte famille;
+    unsigned long debut;
+  };
+#endif
+
+  // Page en cours d'envoi (voir streamPage)
+  byte pageSource = 0;  // 0 si aucune page
+  const byte* pageData = NULL;
+#if defined(ARDUINO)
+  Stream* pageFile = NULL;
+#endif
+  MinitelPackedPage* pagePacked = NULL;
+  size_t pageSize = 0;
+  size_t pageOffset = 0;
+  boolean pagePacing = false;
+  unsigned long pageCredit = 0;  // Ce que la ligne peut encore accepter, en millièmes de bit
+  unsigned long pageClock = 0;  // Dernière mise à jour de pageCredit
+  int pageLookahead = -1;  // Octet déjà lu dans un fichier ou une page compressée, pas encore envoyé
+  unsigned long pageLatency = 50;
+  boolean pageCancelKeys = false;
+  const char* statusText = NULL;  // Ligne d'état en attente
+  byte overlayDepth = 0;  // Appels de beginOverlay imbriqués
+  int overlayX = 1, overlayY = 1;  // Position et attributs à rétablir
+  boolean overlayKnown = false;
+  byte overlayAttr[8] = {};
+  byte overlayZone[3] = {};
+  void startPage(byte source, const byte* page, size_t size);
+  size_t pageRead(byte* bloc, size_t n);
+  int pagePeek();
+  boolean pageSafe();
+  void pageBoundary(boolean strict);
+  void sendStatus();
+
+  // Répétition automatique (voir repeatByte)
+  boolean autoRepeat = true;
+  byte repeatChar = 0;  // Dernier caractère visualisé, 0 si aucun ne peut être répété
+  boolean repeatG2 = false;  // repeatChar est un caractère du jeu G2
+  boolean repeatSS2 = false;  // SS2 retenu
+  unsigned int repeatCount = 0;  // Répétitions en attente
+  boolean repeatByte(byte b);
+  void flushRepeat();
+
+  // Suivi du curseur (voir trackByte)
+  int trackX = 1, trackY = 1;  // Colonne et rangée
+  boolean trackKnown = false;  // Position connue
+  byte trackAttr[8] = {};  // Attributs courants (couleur, fond, taille...), 0 si inconnu
+  byte trackZone[3] = {};  // Fond, masquage et lignage validés par le dernier délimiteur, 0 si inconnu
+  boolean trackScroll = false;  // Mode rouleau
+  boolean trackEcho = true;  // Ecran en écho du clavier (par défaut à la mise sous tension)
+  byte trackColumns = 40;  // 80 en mode Mixte
+  byte trackState = 0;  // Séquence en cours d'analyse (ESC, CSI, US...)
+  byte trackCount = 0;  // Paramètres CSI lus ou octets PRO restant à ignorer
+  byte trackParam[2];  // Paramètres CSI ou rangée US
+  byte trackWidth = 1;  // Largeur du dernier caractère visualisé (pour REP), 0 si inconnue
+  void trackByte(byte b);
+  void trackSeparator();
+  byte trackCharWidth();
+  boolean attributesAtDefault();
+  void trackAdvance(int n);
+  void trackRow(int y);
+  void moveRelative(int n, byte code, byte final);
   boolean isValidChar(byte index);
   // boolean isDiacritic(unsigned char caractere);  // Obsolète depuis le 26/02/2023
-  boolean isVisualisable(unsigned long code);
   void writeBytesP(int n);  // Pn, Pr, Pc
+  void frame(int x1, int y1, int x2, int y2, boolean vider, const char* titre);  // rect et panel
+  void printUtf8(MinitelTranscoder& utf8, const byte* source, size_t size);
   
   // Protocole
   void writeBytesPRO(int n);  // PRO1, PRO2 ou PRO3
-  unsigned long identificationBytes();
-  int workingSpeed();
-  byte workingStandard(unsigned long sequence);
-  byte workingMode();
-  byte workingKeyboard();
-  byte workingAiguillage(byte module);
-  byte workingModem();
+  struct Request {
+    byte type;  // Type de réponse attendue, 0 si libre
+    byte generation;  // Pour reconnaître un numéro de requête périmé
+    signed char statut;
+    unsigned long parametre;  // Module ou séquence attendue
+    unsigned long valeur;
+    unsigned long debut;
+    unsigned long delai;
+    MinitelCallback callback;
+  };
+  Request requests[MINITEL_MAX_REQUESTS] = {};
+  unsigned long replyTimeout = 1000;
+  byte rxFrame[6];  // Trame en cours de réception
+  byte rxLength = 0;
+  byte rxExpected = 0;  // Longueur de la trame en cours, 0 si pas encore connue
+  unsigned long rxTime = 0;  // Arrivée du dernier octet
+  MinitelKeyEvent keyEvents[MINITEL_KEY_EVENTS];  // Touches décodées
+  byte keyStart = 0;
+  byte keyCount = 0;
+  byte keyState = 0;  // Décodage de la touche en cours
+  unsigned long keyCode = 0;
+  unsigned long keyTime = 0;  // Réception de son premier octet
+  int reserveRequest();  // Place réservée, -1 si aucune
+  int request(byte i, byte type, unsigned long parametre, MinitelCallback callback);
+  void expireRequests();  // Délais dépassés
+  unsigned long waitReply(int requete);
+  void receiveByte(byte b);
+  boolean matchReply(Request& r, const byte* trame, byte longueur);
+  void completeRequest(byte i, int statut);
+  void releaseFrame();
+  void decodeKey(byte b);
+  void endKey();
+  void pushKey(unsigned long code, unsigned long unicode);
   
   unsigned long getCursorXY();
 };
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Courbe - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+
+   Courbe et jauge de la tension lue sur l'entrée analogique A0, dessinées
+   pixel par pixel avec MinitelCanvas. Seules les cases modifiées sont
+   envoyées au Minitel : quelques octets par mesure. Les deux partagent
+   une zone de 40 x 12 cases, soit 480 octets de mémoire vive : de quoi
+   tenir dans les 2 Ko d'un Arduino Uno.
+
+   Documentation utilisée :
+   Spécifications Techniques d'Utilisation du Minitel 1B
+   http://543210.free.fr/TV/stum1b.pdf
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+////////////////////////////////////////////////////////////////////////
+  DEBUT DU PROGRAMME (Compile sous Arduino 1.8.19)
+*///////////////////////////////////////////////////////////////////////
+
+#include <Minitel1B_Soft.h>  // Voir https://github.com/eserandour/Minitel1B_Soft
+#include <Minitel1B_Canvas.h>
+Minitel minitel(8, 9);  // RX, TX
+byte cases[40*12];  // Un octet par case de la zone
+MinitelCanvas dessin(minitel, cases, sizeof(cases));
+
+const int LARGEUR = 68;  // Pixels 0 à 67 : courbe, 72 à 79 : jauge
+
+int x = 0;  // Colonne de pixels de la prochaine mesure
+int yAvant = 0;  // Mesure précédente (0 : aucune)
+
+////////////////////////////////////////////////////////////////////////
+
+void setup() {
+  minitel.changeSpeed(minitel.searchSpeed());
+  minitel.newScreen();
+  minitel.noCursor();
+  minitel.print("Tension sur A0");
+  dessin.setArea(1, 3, 40, 12);  // 80 x 36 pixels
+  dessin.rect(0, 0, LARGEUR-1, dessin.height()-1);
+  dessin.flush();
+}
+
+////////////////////////////////////////////////////////////////////////
+
+void loop() {
+  int h = dessin.height() - 2;
+  int y = h - map(analogRead(A0), 0, 1023, 0, h-1);  // De 1 à h
+
+  // La colonne suivante est effacée : elle sépare l'ancienne courbe de la nouvelle.
+  dessin.line(x+1, 1, x+1, h, false);
+  dessin.line(x+2, 1, x+2, h, false);
+  if (yAvant > 0) dessin.line(x, yAvant, x+1, y);
+  else dessin.setPixel(x+1, y);
+  x = (x + 1) % (LARGEUR - 3);
+  yAvant = (x > 0) ? y : 0;
+
+  dessin.fillRect(LARGEUR+4, 0, dessin.width()-1, y-1, false);
+  dessin.fillRect(LARGEUR+4, y, dessin.width()-1, dessin.height()-1);
+
+  dessin.flush();
+  delay(100);
+}
+
+////////////////////////////////////////////////////////////////////////
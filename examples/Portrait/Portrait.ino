@@ -1,7 +1,7 @@
 ////////////////////////////////////////////////////////////////////////
 /*
-   Portrait - Version du 24 avril 2022 à 01h20
-   Copyright 2017-2022 - Eric Sérandour
+   Portrait - Version du 17 octobre 2026
+   Copyright 2017-2026 - Eric Sérandour
    
    Attention : Ce programme fonctionne bien sur un ATMega 328P.
    Sur un microcontrôleur qui dispose de moins de mémoire,
@@ -47,14 +47,16 @@ void setup() {
   Serial.begin(9600);  // Port série matériel de l'ATmega à 9600 bauds.
   minitel.changeSpeed(minitel.searchSpeed());
   minitel.newScreen();
+  minitel.beginPage_P(PORTRAIT, LONGUEUR_TRAME_PORTRAIT);
 }
 
 ////////////////////////////////////////////////////////////////////////
 
 void loop() {
   // Voir https://github.com/eserandour/Conversion_Videotex_Hex
-  for (int i=0; i<LONGUEUR_TRAME_PORTRAIT; i++) {
-    minitel.writeByte(pgm_read_byte_near(PORTRAIT + i));
+  // La page part par blocs : loop() reprend la main entre deux blocs.
+  if (!minitel.streamPage()) {
+    minitel.beginPage_P(PORTRAIT, LONGUEUR_TRAME_PORTRAIT);  // Page terminée : on recommence.
   }
 }
 
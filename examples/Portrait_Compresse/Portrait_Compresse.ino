@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Portrait_Compresse - Version du 17 octobre 2026
+   Copyright 2017-2026 - Eric Sérandour
+
+   Même page que l'exemple Portrait, compressée avec
+   extras/Linux/Compresseur_Pages.cpp : 1518 octets de mémoire flash au
+   lieu de 4802. Elle est décompressée au fil de l'envoi.
+
+   Documentation utilisée :
+   Spécifications Techniques d'Utilisation du Minitel 1B
+   http://543210.free.fr/TV/stum1b.pdf
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+////////////////////////////////////////////////////////////////////////
+  DEBUT DU PROGRAMME (Compile sous Arduino 1.8.19)
+*///////////////////////////////////////////////////////////////////////
+
+#include <Minitel1B_Soft.h>  // Voir https://github.com/eserandour/Minitel1B_Soft
+Minitel minitel(8, 9);  // RX, TX
+
+////////////////////////////////////////////////////////////////////////
+
+// ./compresseur portrait.vdt PORTRAIT > portrait.h
+const byte PORTRAIT[] PROGMEM = {0x56,0xC2,0x12,0x0C,0x0E,0x1B,0x42,0x1B,0x56,0x37,0x1B,0x46,0xC4,0xF4,0x27,0xF4,
+  0x94,0x0E,0x53,0x3F,0x1B,0x43,0xC4,0xF4,0x2B,0xE4,0x23,0xE4,0x67,0x81,0x18,0x68,
+  0x1B,0x41,0x1B,0x56,0x7C,0xD4,0x55,0x3F,0xE4,0x6F,0xD4,0xF9,0x51,0x2F,0xD4,0x52,
+  0x3F,0xE4,0x27,0xE4,0x2B,0xD4,0x56,0x2F,0xE4,0x2B,0xEE,0xF9,0x7F,0x1B,0x45,0xC4,
+  0x30,0x81,0x63,0x6B,0xE4,0x23,0xE4,0xF9,0x2B,0xE4,0xF9,0x68,0xF4,0x87,0x18,0x80,
+  0xB3,0xF4,0x52,0x28,0xE4,0x6B,0xF4,0x84,0xA9,0x8E,0xCC,0xF9,0x77,0x8A,0x09,0x53,
+  0x37,0x81,0xB8,0x77,0xE4,0x33,0xC4,0x86,0xD6,0x41,0x83,0xC7,0x55,0x37,0x1B,0x45,
+  0x80,0xAE,0xC4,0x80,0x63,0xC4,0x80,0xE5,0xF4,0x81,0x72,0xD4,0xF4,0x84,0xA4,0x60,
+  0xE9,0x78,0x81,0x2C,0x68,0x81,0xCC,0x28,0xE4,0x7F,0x81,0x18,0x30,0x8B,0xB3,0x6C,
+  0xF9,0x87,0xCC,0x8C,0x04,0x80,0x45,0xF4,0x52,0xF4,0x28,0x8B,0xC2,0xF4,0x3F,0x89,
+  0xC2,0x83,0x7C,0xF4,0x53,0x7F,0x1B,0x43,0x82,0xCC,0x89,0xD1,0x7F,0x81,0x86,0x68,
+  0x81,0x95,0x37,0x82,0xA9,0x85,0x40,0xF4,0x53,0x2F,0xE4,0x2B,0xEE,0x27,0xE4,0xF9,
+  0x28,0x80,0x27,0xF4,0x52,0x6B,0x85,0xCC,0x55,0x68,0xC9,0x84,0x6D,0x6F,0xE4,0xF4,
+  0x28,0xF9,0x86,0xB8,0x7B,0x95,0xC7,0x6B,0xF4,0x95,0xC7,0x7F,0xF9,0x86,0x13,0x74,
+  0x82,0xC7,0x86,0xBD,0xF9,0x7C,0xE4,0x81,0x81,0x55,0x74,0x81,0x4A,0x8C,0x45,0x77,
+  0xD4,0x53,0x70,0xE4,0x78,0xEE,0x30,0xE4,0x70,0xF4,0x81,0x81,0x78,0xD4,0x52,0x83,
+  0xCC,0x82,0xC7,0xC4,0x84,0x36,0x68,0x86,0xC2,0x20,0xE4,0x7B,0x8C,0xD1,0xF4,0x87,
+  0x13,0x81,0x4A,0x82,0xC7,0x68,0xEE,0x8D,0x81,0xF4,0xFE,0xF4,0x84,0x86,0x84,0xC2,
+  0x37,0xE4,0x33,0xE4,0x82,0xA9,0x28,0x81,0x86,0x27,0x1B,0x42,0x85,0x3B,0xC9,0x81,
+  0xA9,0x45,0xF4,0xF4,0x84,0xB8,0x74,0xF9,0x80,0x2C,0xF4,0x52,0x7C,0xE4,0xF4,0x81,
+  0x22,0x55,0x78,0x86,0xC7,0x6B,0xE4,0x7C,0x86,0xAE,0x6C,0x8B,0xBD,0x6B,0xF9,0x88,
+  0x04,0x42,0xD4,0x82,0xC7,0x95,0xC2,0x3F,0x86,0x13,0x7F,0x86,0x13,0x27,0x82,0xBD,
+  0xE4,0x7F,0xE4,0x3C,0xE4,0x37,0x81,0x9F,0x6F,0x81,0x4A,0x86,0x9F,0x55,0xE4,0x51,
+  0xF4,0x70,0xE4,0x77,0x82,0xE5,0xC9,0x81,0x86,0x44,0xCE,0x78,0xE4,0x6C,0xE4,0x74,
+  0x81,0x1D,0x33,0xD4,0x55,0x37,0x82,0xC7,0x86,0x9F,0x78,0xF4,0xFE,0xF4,0x86,0xDB,
+  0x6F,0x96,0xC7,0x8B,0xB3,0x77,0xF9,0x87,0xC2,0x86,0x1D,0x34,0xD4,0x53,0xDE,0x84,
+  0xC2,0x74,0xE4,0xFE,0x7C,0x1B,0x45,0xC4,0x68,0xD4,0x52,0x28,0xD4,0x55,0x6B,0x81,
+  0x95,0x2F,0x1B,0x44,0xD4,0xD9,0x52,0xF4,0x27,0x81,0x6D,0x82,0xEF,0x68,0xCE,0x84,
+  0x18,0x27,0xE4,0x23,0xE4,0x2F,0xF4,0x81,0x1D,0x77,0xE4,0x30,0x86,0xC2,0x7B,0x8C,
+  0xB3,0x86,0xC7,0x6B,0x91,0xC7,0x86,0xBD,0xF4,0x3C,0xE4,0x74,0x86,0xC2,0x77,0x86,
+  0x4F,0x37,0x8B,0xCC,0x30,0x81,0xC7,0x77,0xE9,0x82,0x4A,0x78,0xE4,0x37,0xE4,0x23,
+  0x90,0x04,0x2B,0x86,0x1D,0x80,0xEA,0x82,0xD6,0xC4,0x2F,0xEE,0xF4,0x63,0xEE,0x82,
+  0xE0,0xC4,0x45,0x84,0x68,0x78,0x90,0xC2,0x78,0xF4,0xF4,0x9A,0xC7,0x37,0x95,0x09,
+  0xF4,0x27,0xF9,0xF4,0x81,0xC2,0x3F,0x86,0xC7,0x78,0x81,0x7C,0x6B,0x1B,0x42,0x82,
+  0xE5,0xC4,0x70,0xE4,0xF4,0x6B,0xE4,0x87,0xE5,0x70,0xF4,0x81,0xC7,0xD9,0xC4,0x37,
+  0xFE,0xE4,0x78,0x81,0x13,0x78,0x82,0xC7,0xEE,0x37,0x86,0xA4,0x7C,0x86,0xB3,0x6C,
+  0xF9,0x87,0x54,0xF4,0x87,0x5E,0x86,0xC7,0x7F,0xC4,0x84,0x86,0x77,0xF4,0x86,0x13,
+  0xF9,0x3F,0xFE,0x86,0x9F,0x82,0xBD,0x74,0xE4,0x70,0xE4,0x23,0x1B,0x42,0xC4,0x28,
+  0x81,0x8B,0x6F,0xC9,0xC4,0x77,0xD4,0x56,0x74,0x81,0x27,0xF4,0x28,0x81,0xE5,0x68,
+  0x81,0xA4,0x7C,0xD4,0xF4,0x51,0x7C,0x81,0x2C,0x34,0x82,0x7C,0xC9,0xF4,0x84,0x1D,
+  0x23,0x81,0x3B,0x27,0x82,0x9F,0x8C,0xCC,0x8B,0x0E,0xF9,0x78,0xFE,0x87,0xC7,0x8B,
+  0xBD,0x37,0xE4,0x73,0x86,0x86,0x3F,0x86,0xE0,0x30,0xE4,0xF4,0x7F,0x85,0x4F,0xF4,
+  0x53,0x7F,0xE4,0x28,0x81,0x4F,0x68,0xD4,0x52,0x37,0xE4,0x27,0x87,0x4A,0x82,0x68,
+  0x81,0xAE,0x23,0x1B,0x41,0xC4,0xF4,0x2B,0xCE,0x84,0x27,0x74,0x86,0xC7,0x6B,0xC4,
+  0x84,0x31,0x23,0x87,0xBD,0xF4,0x87,0xC7,0x8C,0x13,0x86,0x72,0x78,0xF4,0x86,0x9A,
+  0x74,0x87,0xCC,0xF9,0x86,0x18,0xF9,0x7C,0x86,0xC7,0xF9,0x7F,0xF4,0x87,0x3B,0x81,
+  0x54,0x20,0x82,0xC2,0xE4,0x74,0xE4,0x70,0xE4,0x80,0xC2,0xE9,0x41,0xD4,0xD9,0xF9,
+  0xF4,0x55,0x70,0xF4,0x81,0xC2,0x34,0xE4,0x68,0x86,0xC7,0x70,0xF4,0x8B,0xBD,0x60,
+  0xFE,0x95,0xC7,0xF4,0x78,0x86,0x36,0x3F,0x8C,0xBD,0xF4,0x87,0xE0,0xF4,0x8B,0xC7,
+  0x70,0x8C,0x04,0x81,0x8B,0x6B,0xC4,0x80,0xC7,0xE4,0x68,0x81,0xB3,0x2C,0xE4,0x23,
+  0xEE,0x73,0xC4,0xD9,0xF9,0x86,0xC7,0x23,0xE4,0xF9,0x3C,0x81,0x95,0x23,0x82,0x5E,
+  0x86,0xA9,0x60,0x87,0xC7,0xF9,0x8C,0x04,0x81,0x31,0x78,0x86,0xC7,0x82,0x13,0x37,
+  0x86,0xA4,0x70,0x90,0xC2,0x78,0x86,0xB8,0xFE,0xF4,0x60,0xF9,0x8D,0xD6,0x41,0xC4,
+  0x68,0xD4,0x55,0x30,0xE4,0x82,0xCC,0x7C,0xC4,0xC9,0x7C,0xEE,0x2F,0x94,0x04,0x51,
+  0x7C,0x1B,0x44,0xC9,0xE4,0x56,0x34,0x87,0xC7,0x87,0xC2,0xFE,0x8C,0x04,0x81,0xC2,
+  0x68,0x86,0xC2,0xF4,0x82,0x18,0x3F,0x90,0xCC,0x33,0xE4,0xFE,0x7F,0xF4,0x87,0xB8,
+  0xF4,0x87,0xEA,0x86,0x31,0x82,0xAE,0x78,0x80,0x90,0x51,0x7F,0xC4,0xC9,0x74,0x86,
+  0xCC,0x23,0xE4,0x70,0x1B,0xF4,0x41,0xC4,0x78,0xC9,0x84,0x1D,0x78,0xD4,0x51,0x34,
+  0x80,0x2C,0x54,0x68,0x82,0x36,0x80,0x18,0x56,0x30,0x87,0x63,0x8C,0xBD,0x86,0x13,
+  0x68,0x86,0xC7,0x78,0x87,0xCC,0x8B,0xAE,0x70,0x8C,0xA4,0x87,0xBD,0x86,0x22,0x77,
+  0xFE,0xFE,0xF9,0x87,0x22,0x81,0xBD,0x6B,0xD4,0x54,0x6F,0xE4,0x30,0x86,0xD1,0x7C,
+  0xE4,0x81,0xC2,0xF9,0x51,0xF4,0xF4,0x34,0x81,0xC7,0x63,0xD9,0x54,0x7C,0xE4,0x37,
+  0xDE,0x56,0x37,0x86,0xB3,0x70,0x8C,0xC7,0x84,0xC2,0xD9,0xF4,0x8B,0xC7,0x82,0x1D,
+  0x30,0x87,0xCC,0x86,0x95,0x34,0x86,0x18,0xF4,0x3F,0x87,0x1D,0xF4,0x8D,0xC2,0x45,
+  0xC4,0x60,0x80,0x8B,0x52,0x82,0x9F,0x77,0xD4,0x54,0x2B,0xE4,0x64,0xE4,0x20,0xE4,
+  0x2F,0xE4,0xF4,0x27,0xD4,0x51,0x37,0x81,0xC2,0x78,0xD9,0xF4,0x54,0x3F,0xE9,0x73,
+  0xD4,0x52,0x77,0x8B,0xB8,0x70,0x90,0xC7,0x87,0xBD,0x8A,0xCC,0x84,0xB3,0xF4,0x7F,
+  0x86,0xD1,0xF4,0x73,0x8B,0xAE,0x83,0x63,0xFE,0x84,0x2C,0x81,0xBD,0x41,0xC4,0x70,
+  0x86,0xC2,0x28,0xD4,0x54,0x6F,0xE4,0x74,0xE4,0x70,0x8B,0xD1,0xFE,0x82,0x27,0x74,
+  0xE4,0xF9,0x37,0xD4,0x55,0x6B,0x86,0x18,0x7F,0x1B,0x45,0x1B,0x56,0x30,0x86,0xC2,
+  0x7C,0xF9,0xF9,0x86,0xC2,0x96,0x04,0x77,0xC4,0x80,0x95,0x8B,0x9F,0x37,0xE4,0xF9,
+  0x7C,0x86,0xC2,0x70,0x86,0xC7,0x80,0x6D,0x82,0xC2,0xDE,0x82,0x90,0x86,0xBD,0xF9,
+  0x6C,0xE4,0x7B,0xE4,0x70,0x8B,0xD1,0x23,0xE4,0x2F,0x86,0x2C,0x30,0x82,0xC7,0xE4,
+  0x68,0xEE,0x24,0xE4,0xFE,0x77,0xD4,0x52,0x7F,0xC4,0x80,0x7C,0x81,0x63,0x70,0x81,
+  0x9F,0x30,0x8B,0xB3,0x68,0x90,0x09,0x74,0xE4,0x82,0xEF,0x74,0x86,0xAE,0xF4,0x77,
+  0x86,0xDB,0x7C,0x86,0xB8,0x70,0x81,0x63,0x7C,0xD4,0x51,0xF4,0x7B,0xE4,0x2C,0x82,
+  0x9F,0x8B,0xA4,0x2B,0xE4,0x60,0x86,0xDB,0x28,0xF9,0x86,0xD1,0x78,0xE4,0x74,0x85,
+  0xC7,0x55,0x68,0x86,0x18,0x77,0xE4,0x37,0x86,0x2C,0x74,0xE4,0x7F,0x83,0xD6,0x41,
+  0xC4,0x30,0x87,0xB8,0x90,0x04,0x77,0xE4,0x34,0x84,0xD1,0x80,0xA9,0x84,0xD1,0xF9,
+  0x84,0xBD,0x78,0xC4,0x84,0xB8,0x20,0xE4,0x6B,0x87,0x95,0x86,0x6D,0x3F,0xD4,0xF4,
+  0x51,0x78,0xE4,0x7C,0xEE,0x20,0x86,0xD1,0x64,0xE4,0x70,0xFE,0x86,0xEA,0x37,0x86,
+  0xC7,0x7C,0xEE,0x27,0xE4,0x3F,0x86,0xC7,0x7F,0xE4,0x7B,0xE4,0x6F,0x85,0xE0,0x51,
+  0x7F,0xC4,0x84,0xA9,0x60,0x90,0xC7,0x74,0xE4,0x7C,0xE4,0xF9,0x70,0x1B,0x45,0xC4,
+  0x60,0x81,0xFE,0x82,0xB8,0xF4,0xF4,0x74,0xE4,0x70,0xE4,0xFE,0x30,0x82,0x63,0x86,
+  0x72,0x24,0xE4,0x78,0x86,0x13,0x6C,0xE4,0x27,0x86,0xE5,0x63,0xE4,0x23,0xE4,0x2F,
+  0xE4,0x2C,0x82,0xC2,0xE4,0x6F,0xEE,0x7C,0xE4,0x3F,0x86,0x31,0xF4,0x33,0x86,0xC7,
+  0x2F,0x86,0x45,0x34,0x86,0xCC,0x74,0x95,0xC7,0x77,0x1B,0xF4,0x41,0x83,0xC2,0x55,
+  0x7C,0xC4,0x84,0xB3,0x2B,0x86,0x68,0x38,0xE4,0x68,0x86,0xA4,0x77,0xD4,0x51,0x3F,
+  0xE9,0x6F,0x86,0xC2,0x27,0x86,0xD6,0x70,0x86,0x18,0x60,0xE4,0xF4,0x87,0xB3,0x30,
+  0xD4,0x51,0x77,0xE4,0x68,0x86,0xA9,0x37,0xE4,0xF4,0x6F,0x86,0x45,0x24,0xE4,0x73,
+  0x86,0x36,0x23,0xE4,0x30,0x84,0x1D,0x81,0xAE,0x45,0xC4,0x30,0xC4,0x86,0xC7,0xF4,
+  0x41,0xDE,0xD4,0x51,0x7C,0x81,0x5E,0x63,0xE4,0x78,0x86,0x9F,0x34,0xE4,0x77,0xE4,
+  0x74,0xE4,0xF9,0x63,0x86,0xD1,0x33,0xE4,0x77,0x86,0xBD,0x68,0x86,0x90,0xFE,0x7B,
+  0xE4,0xF9,0x7F,0xF4,0x86,0xEF,0x73,0x82,0xC7,0x86,0xE5,0x3F,0xE4,0x7F,0x90,0x04,
+  0x7C,0x86,0x45,0x33,0x86,0x5E,0x74,0x85,0x1D,0x55,0x80,0xCC,0xC4,0x30};
+
+MinitelPackedPage page;  // Fenêtre de décompression : 256 octets de mémoire vive
+
+////////////////////////////////////////////////////////////////////////
+
+void setup() {
+  Serial.begin(9600);  // Port série matériel de l'ATmega à 9600 bauds.
+  minitel.changeSpeed(minitel.searchSpeed());
+  minitel.newScreen();
+  page.begin_P(PORTRAIT, sizeof(PORTRAIT));
+  minitel.beginPage(page);
+}
+
+////////////////////////////////////////////////////////////////////////
+
+void loop() {
+  if (!minitel.streamPage()) {
+    page.begin_P(PORTRAIT, sizeof(PORTRAIT));  // Page terminée : on recommence.
+    minitel.beginPage(page);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////
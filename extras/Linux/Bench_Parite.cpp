@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Bench_Parite - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+
+   Mesure du débit (octets par seconde) du calcul de la parité paire :
+   - boucle bit à bit (ancienne version de writeByte)
+   - table PARITE, octet par octet (writeByte)
+   - encodage par blocs (encodeParity / decodeParity)
+
+   Compilation (depuis la racine de la bibliothèque) :
+   g++ -O2 -I. Minitel1B_Soft.cpp Minitel1B_Host.cpp extras/Linux/Bench_Parite.cpp -o bench_parite
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#include "Minitel1B_Soft.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+const size_t TAILLE = 1 << 20;  // 1 Mo par passe
+const int PASSES = 64;
+
+// Ancienne version de writeByte, sans l'envoi
+static byte pariteBitABit(byte b) {
+  boolean parite = 0;
+  for (int i=0; i<7; i++) {
+    if (bitRead(b,i) == 1)  {
+      parite = !parite;
+    }
+  }
+  if (parite) {
+    bitWrite(b,7,1);
+  }
+  else {
+    bitWrite(b,7,0);
+  }
+  return b;
+}
+
+static void afficher(const char *nom, unsigned long debut, unsigned long somme) {
+  double secondes = (micros() - debut) / 1e6;
+  printf("%-28s %10.1f Mo/s  (controle %lu)\n", nom, (double) TAILLE * PASSES / secondes / 1e6, somme);
+}
+
+int main() {
+  byte *source = (byte *) malloc(TAILLE);
+  byte *destination = (byte *) malloc(TAILLE);
+  srand(3615);
+  for (size_t i=0; i<TAILLE; i++) source[i] = rand() & 0x7F;
+
+  // Boucle bit à bit
+  unsigned long somme = 0;
+  unsigned long debut = micros();
+  for (int p=0; p<PASSES; p++) {
+    for (size_t i=0; i<TAILLE; i++) destination[i] = pariteBitABit(source[i]);
+    somme += destination[p];
+  }
+  afficher("Boucle bit a bit", debut, somme);
+
+  // Table, octet par octet (comme writeByte)
+  somme = 0;
+  debut = micros();
+  for (int p=0; p<PASSES; p++) {
+    for (size_t i=0; i<TAILLE; i++) Minitel::encodeParity(source + i, destination + i, 1);
+    somme += destination[p];
+  }
+  afficher("Table, octet par octet", debut, somme);
+
+  // Encodage par blocs
+  somme = 0;
+  debut = micros();
+  for (int p=0; p<PASSES; p++) {
+    Minitel::encodeParity(source, destination, TAILLE);
+    somme += destination[p];
+  }
+  afficher("encodeParity (bloc)", debut, somme);
+
+  // Vérification
+  for (size_t i=0; i<TAILLE; i++) {
+    if (destination[i] != pariteBitABit(source[i])) {
+      printf("Erreur d'encodage a l'octet %lu\n", (unsigned long) i);
+      return 1;
+    }
+  }
+
+  // Décodage par blocs
+  somme = 0;
+  debut = micros();
+  for (int p=0; p<PASSES; p++) {
+    somme += Minitel::decodeParity(destination, source, TAILLE);
+  }
+  afficher("decodeParity (bloc)", debut, somme);
+
+  free(source);
+  free(destination);
+  return 0;
+}
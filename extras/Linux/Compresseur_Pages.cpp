@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Compresseur_Pages - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+
+   Compresse une page Vidéotex (fichier .vdt) au format de
+   MinitelPackedPage et l'écrit sous forme de tableau PROGMEM, prêt à
+   être collé dans un programme Arduino. La page est décompressée pour
+   vérification ; le taux de compression est affiché sur stderr.
+
+   Compilation (depuis la racine de la bibliothèque) :
+   g++ -O2 -I. Minitel1B_Soft.cpp Minitel1B_Host.cpp extras/Linux/Compresseur_Pages.cpp -o compresseur
+
+   Utilisation :
+   ./compresseur page.vdt PAGE > page.h
+
+   Dans le programme Arduino :
+   MinitelPackedPage page;
+   page.begin_P(PAGE, sizeof(PAGE));
+   minitel.beginPage(page);
+   while (minitel.streamPage());
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#include "Minitel1B_Soft.h"
+#include <stdio.h>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Utilisation : %s page.vdt [NOM] > page.h\n", argv[0]);
+    return 1;
+  }
+  const char *nom = (argc > 2) ? argv[2] : "PAGE";
+  FILE *f = fopen(argv[1], "rb");
+  if (f == NULL) {
+    perror(argv[1]);
+    return 1;
+  }
+  std::vector<byte> page;
+  int c;
+  while ((c = fgetc(f)) != EOF) page.push_back((byte) c);
+  fclose(f);
+
+  std::vector<byte> compressee = MinitelPackedPage::pack(page.data(), page.size());
+  if (compressee.empty()) {
+    fprintf(stderr, "%s : page trop grande (65535 octets au plus)\n", argv[1]);
+    return 1;
+  }
+
+  // Vérification : la parité étant recalculée à l'envoi, seuls 7 bits comptent.
+  MinitelPackedPage verification;
+  verification.begin(compressee.data(), compressee.size());
+  std::vector<byte> retour(page.size() + 1);
+  size_t n = 0;
+  size_t lus;
+  while ((lus = verification.read(retour.data() + n, retour.size() - n)) > 0) n += lus;
+  boolean identique = (n == page.size());
+  for (size_t i=0; identique && i<n; i++) identique = (retour[i] == (page[i] & 0x7F));
+  if (!identique) {
+    fprintf(stderr, "%s : erreur de décompression\n", argv[1]);
+    return 1;
+  }
+
+  printf("// %s : %zu octets, %zu octets compressés (voir Compresseur_Pages.cpp)\n",
+         argv[1], page.size(), compressee.size());
+  printf("const byte %s[] PROGMEM = {", nom);
+  for (size_t i=0; i<compressee.size(); i++) {
+    printf("%s0x%02X", (i == 0) ? "" : (i % 16 == 0) ? ",\n  " : ",", compressee[i]);
+  }
+  printf("};\n");
+  fprintf(stderr, "%s : %zu => %zu octets (%.1f %%)\n", argv[1], page.size(), compressee.size(),
+          100.0 * compressee.size() / (page.size() ? page.size() : 1));
+  return 0;
+}
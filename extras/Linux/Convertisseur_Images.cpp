@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Convertisseur_Images - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+
+   Convertit une image PGM ou PPM binaire (P5 ou P6, 255 niveaux au plus)
+   en page Vidéotex semi-graphique (voir MinitelImage), puis mesure le
+   nombre d'images converties par seconde, avec et sans l'envoi des seules
+   cases modifiées d'une image à la suivante.
+   Sans image, une mire en dégradé est convertie.
+   ImageMagick produit le format attendu : convert photo.jpg photo.ppm
+
+   Compilation (depuis la racine de la bibliothèque) :
+   g++ -O3 -pthread -I. Minitel1B_Soft.cpp Minitel1B_Host.cpp Minitel1B_Screen.cpp Minitel1B_Image.cpp extras/Linux/Convertisseur_Images.cpp -o convertisseur
+
+   Utilisation :
+   ./convertisseur photo.ppm page.vdt
+   ./convertisseur
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#include "Minitel1B_Image.h"
+#include <stdio.h>
+
+// Lecture d'un entier de l'en-tête PNM (les commentaires sont sautés)
+static int entier(FILE* f) {
+  int c = fgetc(f);
+  while (c == '#' || c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+    if (c == '#') while (c != '\n' && c != EOF) c = fgetc(f);
+    c = fgetc(f);
+  }
+  int n = -1;
+  while (c >= '0' && c <= '9') {
+    n = ((n < 0) ? 0 : n * 10) + (c - '0');
+    c = fgetc(f);
+  }
+  return n;  // Le blanc qui suit le nombre est consommé.
+}
+
+static bool lire(const char* fichier, std::vector<byte>& pixels, int& largeur, int& hauteur, int& canaux) {
+  FILE* f = fopen(fichier, "rb");
+  if (f == NULL) {
+    perror(fichier);
+    return false;
+  }
+  bool ok = (fgetc(f) == 'P');
+  int type = fgetc(f);
+  canaux = (type == '5') ? 1 : (type == '6') ? 3 : 0;
+  largeur = entier(f);
+  hauteur = entier(f);
+  int maximum = entier(f);
+  ok = ok && canaux > 0 && largeur > 0 && hauteur > 0 && maximum > 0 && maximum < 256;
+  if (ok) {
+    pixels.resize((size_t) largeur * hauteur * canaux);
+    ok = (fread(pixels.data(), 1, pixels.size(), f) == pixels.size());
+  }
+  fclose(f);
+  if (!ok) fprintf(stderr, "%s : image PGM (P5) ou PPM (P6) attendue\n", fichier);
+  return ok;
+}
+
+static double secondes(unsigned long debut) {
+  return (millis() - debut) / 1000.0;
+}
+
+int main(int argc, char *argv[]) {
+  std::vector<byte> pixels;
+  int largeur, hauteur, canaux;
+  if (argc > 1) {
+    if (!lire(argv[1], pixels, largeur, hauteur, canaux)) return 1;
+  }
+  else {
+    // Mire : dégradé horizontal, cercle clair au centre
+    largeur = 640;
+    hauteur = 480;
+    canaux = 1;
+    pixels.resize((size_t) largeur * hauteur);
+    for (int y=0; y<hauteur; y++) {
+      for (int x=0; x<largeur; x++) {
+        int dx = x - largeur/2, dy = y - hauteur/2;
+        pixels[(size_t) y * largeur + x] = (dx*dx + dy*dy < 150*150) ? 255 - x * 255 / largeur : x * 255 / largeur;
+      }
+    }
+  }
+
+  MinitelMemoryTransport sortie;
+  Minitel minitel(sortie);
+  minitel.setNativeParity(true);  // Octets de 7 bits dans le fichier
+  minitel.setAutoFlush(MINITEL_TX_BUFFER_SIZE);
+  MinitelScreen ecran(minitel);
+  MinitelImage image;
+  image.convert(pixels.data(), largeur, hauteur, canaux, ecran);
+  ecran.commit();
+  minitel.flush();
+  size_t taille = sortie.output().size();
+  if (argc > 2) {
+    FILE* f = fopen(argv[2], "wb");
+    if (f == NULL || fwrite(sortie.output().data(), 1, taille, f) != taille) {
+      perror(argv[2]);
+      return 1;
+    }
+    fclose(f);
+  }
+  printf("%d x %d pixels => %zu octets (%.1f s à 1200 bauds)\n", largeur, hauteur, taille, taille * 10.0 / 1200);
+
+  // Mesures
+  unsigned long debut = millis();
+  unsigned long images = 0;
+  while (secondes(debut) < 1.0) {
+    image.convert(pixels.data(), largeur, hauteur, canaux, ecran);
+    images++;
+  }
+  printf("Conversion : %.0f images par seconde\n", images / secondes(debut));
+  debut = millis();
+  images = 0;
+  while (secondes(debut) < 1.0) {
+    // Image décalée d'une ligne à chaque fois, comme une vidéo
+    int decalage = (int) (images % 2);
+    image.convert(pixels.data() + (size_t) decalage * largeur * canaux, largeur, hauteur - decalage, canaux, ecran);
+    ecran.commit();
+    minitel.flush();
+    images++;
+  }
+  printf("Conversion et envoi des cases modifiées : %.0f images par seconde (%zu octets au total)\n",
+         images / secondes(debut), sortie.output().size() - taille);
+  return 0;
+}
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Emulateur_Linux - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+
+   Affiche sous forme de texte ce que montrerait l'écran du Minitel :
+   - soit pour une page Vidéotex enregistrée (fichier .vdt),
+   - soit pour une page dessinée par la bibliothèque (Minitel relié à
+     l'émulateur, qui répond aussi aux commandes du protocole).
+   Le nombre de pages interprétées par seconde est ensuite mesuré.
+
+   Compilation (depuis la racine de la bibliothèque) :
+   g++ -O2 -I. Minitel1B_Soft.cpp Minitel1B_Host.cpp Minitel1B_Screen.cpp Minitel1B_Emulator.cpp extras/Linux/Emulateur_Linux.cpp -o emulateur
+
+   Utilisation :
+   ./emulateur page.vdt
+   ./emulateur
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#include "Minitel1B_Emulator.h"
+#include <stdio.h>
+#include <time.h>
+#include <vector>
+
+// Page de démonstration dessinée par la bibliothèque
+static void dessiner(Minitel& minitel) {
+  minitel.newScreen();
+  minitel.attributs(DOUBLE_HAUTEUR);
+  minitel.moveCursorXY(12,3);
+  minitel.print("3615 MINITEL");
+  minitel.attributs(GRANDEUR_NORMALE);
+  minitel.moveCursorXY(1,5);
+  minitel.println("Déjà à l'écran : été, noël, œuvre.");
+  minitel.rect(5, 8, 36, 16);
+  minitel.moveCursorXY(8,12);
+  char vitesse[32];
+  snprintf(vitesse, sizeof(vitesse), "Vitesse : %d bauds", minitel.currentSpeed());
+  minitel.print(vitesse);
+}
+
+int main(int argc, char *argv[]) {
+  MinitelEmulator emulateur;
+  std::vector<byte> page;
+  if (argc > 1) {
+    FILE *f = fopen(argv[1], "rb");
+    if (f == NULL) {
+      perror(argv[1]);
+      return 1;
+    }
+    int c;
+    while ((c = fgetc(f)) != EOF) page.push_back((byte) c);
+    fclose(f);
+    emulateur.receive(page.data(), page.size());
+  }
+  else {
+    Minitel minitel(emulateur);
+    dessiner(minitel);
+    minitel.flush();
+  }
+  printf("%s", emulateur.text().c_str());
+
+  // Mesure : interprétation répétée de la page pendant une seconde
+  clock_t debut = clock();
+  unsigned long pages = 0;
+  if (argc > 1) {
+    while (clock() - debut < CLOCKS_PER_SEC) {
+      emulateur.receive(page.data(), page.size());
+      pages++;
+    }
+  }
+  else {
+    Minitel minitel(emulateur);
+    while (clock() - debut < CLOCKS_PER_SEC) {
+      dessiner(minitel);
+      minitel.flush();
+      while (emulateur.available() > 0) emulateur.read();  // Réponses non lues
+      pages++;
+    }
+  }
+  printf("%lu pages par seconde\n", pages);
+  return 0;
+}
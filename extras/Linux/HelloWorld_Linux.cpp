@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   HelloWorld_Linux - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+
+   Equivalent de l'exemple HelloWorld.ino, compilé nativement sous Linux.
+   Le Minitel est relié au PC par un adaptateur USB-série, ou simulé par
+   un pseudo-terminal.
+
+   Compilation (depuis la racine de la bibliothèque) :
+   g++ -O2 -I. Minitel1B_Soft.cpp Minitel1B_Host.cpp extras/Linux/HelloWorld_Linux.cpp -o hello
+
+   Utilisation :
+   ./hello /dev/ttyUSB0   (port série réel)
+   ./hello                (pseudo-terminal : le nom de l'esclave est affiché)
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#include "Minitel1B_Soft.h"
+#include <stdio.h>
+
+int main(int argc, char *argv[]) {
+  MinitelTransport *transport;
+  if (argc > 1) {
+    transport = new MinitelTtyTransport(argv[1]);
+  }
+  else {
+    MinitelPtyTransport *pty = new MinitelPtyTransport();
+    printf("Pseudo-terminal : %s\n", pty->slaveName());
+    transport = pty;
+  }
+  Minitel minitel(*transport);
+
+  // A la mise sous tension du Minitel, la vitesse des échanges entre
+  // le Minitel et le périphérique est de 1200 bauds par défaut.
+  // On envisage cependant le cas où le Minitel se trouve dans un autre état.
+  if (argc > 1) minitel.changeSpeed(minitel.searchSpeed());
+
+  minitel.newScreen();
+  for (int i=0; i<40; i++) {
+    minitel.print("Hello World ! ");
+  }
+  delete transport;
+  return 0;
+}
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Optimiseur_Pages - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+
+   Réécrit des pages Vidéotex (fichiers .vdt) avec le moins d'octets
+   possible (voir MinitelEmulator::optimize) : attributs redondants,
+   caractères répétés, positionnements absolus... La page obtenue donne
+   exactement le même écran que l'originale (vérifié par l'émulateur).
+
+   Compilation (depuis la racine de la bibliothèque) :
+   g++ -O2 -I. Minitel1B_Soft.cpp Minitel1B_Host.cpp Minitel1B_Screen.cpp Minitel1B_Emulator.cpp extras/Linux/Optimiseur_Pages.cpp -o optimiseur
+
+   Utilisation :
+   ./optimiseur page.vdt page_optimisee.vdt
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#include "Minitel1B_Emulator.h"
+#include <stdio.h>
+
+int main(int argc, char *argv[]) {
+  if (argc < 3) {
+    fprintf(stderr, "Utilisation : %s page.vdt page_optimisee.vdt\n", argv[0]);
+    return 1;
+  }
+  FILE *f = fopen(argv[1], "rb");
+  if (f == NULL) {
+    perror(argv[1]);
+    return 1;
+  }
+  std::vector<byte> page;
+  int c;
+  while ((c = fgetc(f)) != EOF) page.push_back((byte) c);
+  fclose(f);
+
+  std::vector<byte> optimisee = MinitelEmulator::optimize(page.data(), page.size());
+
+  f = fopen(argv[2], "wb");
+  if (f == NULL) {
+    perror(argv[2]);
+    return 1;
+  }
+  if (!optimisee.empty()) fwrite(optimisee.data(), 1, optimisee.size(), f);
+  fclose(f);
+
+  // Un octet dure 10 bits sur la ligne : 8,3 ms à 1200 bauds.
+  long gain = (long) page.size() - (long) optimisee.size();
+  printf("%s : %zu => %zu octets", argv[1], page.size(), optimisee.size());
+  if (gain > 0) {
+    printf(" (%.1f s de moins à 1200 bauds)\n", gain * 10 / 1200.0);
+  }
+  else {
+    printf(" (page inchangée)\n");
+  }
+  return 0;
+}
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Serveur_Minitels - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+
+   Plusieurs Minitel pilotés par un seul processus (voir MinitelServer).
+   Chaque terminal a sa session : une page d'accueil, une horloge mise à
+   jour chaque seconde et une zone de saisie validée par ENVOI.
+   Sans port indiqué, des pseudo-terminaux sont créés (leurs noms sont
+   affichés) : on peut y relier autant d'émulateurs ou de programmes de
+   test.
+
+   Compilation (depuis la racine de la bibliothèque) :
+   g++ -O2 -I. Minitel1B_Soft.cpp Minitel1B_Host.cpp Minitel1B_Server.cpp extras/Linux/Serveur_Minitels.cpp -o serveur
+
+   Utilisation :
+   ./serveur /dev/ttyUSB0 /dev/ttyUSB1 /dev/ttyACM0
+   ./serveur -n 64
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#include "Minitel1B_Server.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define SAISIE_MAX  36  // Caractères de la zone de saisie
+
+class Accueil : public MinitelSession
+{
+public:
+  Accueil(int numero) : numero(numero), seconde(0), longueur(0) {}
+
+  void begin(MinitelTerminal& terminal) {
+    Minitel& minitel = terminal.minitel();
+    minitel.echoAsync(false);  // La session affiche elle-même ce qui est tapé.
+    minitel.newScreen();
+    minitel.attributs(DOUBLE_HAUTEUR);
+    minitel.moveCursorXY(13, 3);
+    minitel.print("3615 SERVEUR");
+    minitel.attributs(GRANDEUR_NORMALE);
+    char texte[40];
+    snprintf(texte, sizeof(texte), "Terminal %d", numero);
+    minitel.moveCursorXY(1, 6);
+    minitel.print(texte);
+    minitel.moveCursorXY(1, 18);
+    minitel.print("Tapez un texte puis ENVOI :");
+    minitel.rect(1, 19, 40, 21);
+    minitel.moveCursorXY(3, 20);
+  }
+
+  void loop(MinitelTerminal& terminal) {
+    Minitel& minitel = terminal.minitel();
+    unsigned long touche;
+    while ((touche = minitel.getKeyCode()) != 0) {
+      if (touche == ENVOI) {
+        saisie[longueur] = '\0';
+        minitel.moveCursorXY(1, 10);
+        minitel.clearLine();
+        minitel.print("Reçu : ");
+        minitel.print(saisie);
+        longueur = 0;
+        minitel.moveCursorXY(3, 20);
+        minitel.printChar(' ');  // Zone de saisie effacée
+        minitel.repeat(SAISIE_MAX - 1);
+        minitel.moveCursorXY(3, 20);
+      }
+      else if (touche == CORRECTION && longueur > 0) {
+        longueur--;
+        minitel.moveCursorXY(3 + longueur, 20);
+        minitel.print(" ");
+        minitel.moveCursorXY(3 + longueur, 20);
+      }
+      else if (touche >= 0x20 && touche < 0x7F && longueur < SAISIE_MAX) {
+        saisie[longueur++] = (char) touche;
+        minitel.printChar((char) touche);
+      }
+    }
+    // Horloge en rangée 0, si la file d'émission n'est pas déjà chargée
+    time_t maintenant = time(NULL);
+    if (maintenant != seconde && terminal.writable()) {
+      seconde = maintenant;
+      char heure[16];
+      strftime(heure, sizeof(heure), "%H:%M:%S", localtime(&maintenant));
+      minitel.newXY(33, 0);
+      minitel.print(heure);
+      minitel.moveCursorXY(3 + longueur, 20);  // Retour dans la zone de saisie
+    }
+  }
+
+  void end(MinitelTerminal& terminal) {
+    (void) terminal;
+    printf("Terminal %d déconnecté\n", numero);
+  }
+
+private:
+  int numero;
+  time_t seconde;
+  char saisie[SAISIE_MAX + 1];
+  int longueur;
+};
+
+int main(int argc, char *argv[]) {
+  std::vector<MinitelFdTransport*> ports;
+  std::vector<int> esclaves;
+  if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+    for (int i=0; i<atoi(argv[2]); i++) {
+      MinitelPtyTransport *pty = new MinitelPtyTransport();
+      printf("Terminal %d : %s\n", i, pty->slaveName());
+      // L'esclave est gardé ouvert : sans lui, le pseudo-terminal serait
+      // vu comme fermé (EPOLLHUP) tant que personne ne l'a ouvert.
+      esclaves.push_back(open(pty->slaveName(), O_RDWR | O_NOCTTY));
+      ports.push_back(pty);
+    }
+  }
+  else {
+    for (int i=1; i<argc; i++) ports.push_back(new MinitelTtyTransport(argv[i]));
+  }
+  if (ports.empty()) {
+    printf("Utilisation : %s /dev/ttyUSB0 [/dev/ttyUSB1...] ou %s -n nombre\n", argv[0], argv[0]);
+    return 1;
+  }
+
+  MinitelServer serveur;
+  std::vector<Accueil*> sessions;
+  for (size_t i=0; i<ports.size(); i++) {
+    sessions.push_back(new Accueil((int) i));
+    if (serveur.add(*ports[i], *sessions[i]) == NULL) printf("Terminal %d : port inaccessible\n", (int) i);
+  }
+  serveur.run();  // Jusqu'à la fermeture du dernier port
+
+  for (size_t i=0; i<ports.size(); i++) {
+    delete sessions[i];
+    delete ports[i];
+  }
+  for (size_t i=0; i<esclaves.size(); i++) {
+    if (esclaves[i] >= 0) close(esclaves[i]);
+  }
+  return 0;
+}
@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Verif_Curseur - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+
+   Vérifie les déplacements optimisés du curseur : des appels tirés au
+   hasard (moveCursorXY, print, graphic, hLine, vLine, rect, textMode,
+   graphicMode, attributs de taille dont les doubles tailles) sont envoyés
+   à MinitelEmulator.
+   - Chaque moveCursorXY et chaque graphic(b, x, y) doit atteindre sa
+     case, d'après l'émulateur, et rect doit laisser le curseur dans son
+     coin supérieur gauche.
+   - Aucun appel ne doit émettre plus d'octets que l'ancienne version de
+     la bibliothèque (adressage CSI systématique, SI à chaque tracé, BS +
+     LF ou VT par rangée de vLine), sauf une exception : en double
+     largeur, vLine et les côtés de rect coûtent un octet de plus par
+     rangée (BS BS au lieu de BS), l'ancienne version décalant le tracé
+     d'une colonne à chaque rangée.
+   Les attributs de taille ne sont envoyés qu'en mode texte : reçus en
+   mode graphique, la bibliothèque ne sait plus quelle taille est en
+   vigueur et revient à l'adressage absolu.
+   Le programme renvoie 1 à la première erreur.
+
+   Compilation (depuis la racine de la bibliothèque) :
+   g++ -O2 -I. Minitel1B_Soft.cpp Minitel1B_Host.cpp Minitel1B_Screen.cpp Minitel1B_Emulator.cpp extras/Linux/Verif_Curseur.cpp -o verif_curseur
+
+   Utilisation :
+   ./verif_curseur [graine]
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#include "Minitel1B_Emulator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+const int APPELS = 200000;
+
+// Emulateur qui compte les octets reçus
+class Compteur : public MinitelEmulator
+{
+public:
+  Compteur() : octets(0) {}
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    octets += size;
+    return MinitelEmulator::write(buffer, size);
+  }
+  unsigned long octets;
+};
+
+// Coûts de l'ancienne version de la bibliothèque
+static int ancienXY(int x, int y) {  // CSI Pr ; Pc H
+  return 4 + (y>9 ? 2 : 1) + (x>9 ? 2 : 1);
+}
+static int ancienHLine(int x1, int y) {  // SI, CSI, caractère, REP n
+  return 1 + ancienXY(x1,y) + 3;
+}
+static int ancienVLine(int x, int y1, int y2, int sens) {  // SI, CSI, puis caractère, BS, LF ou VT par rangée
+  return 1 + ancienXY(x, (sens == DOWN) ? y1 : y2) + 3 * (y2 - y1);
+}
+
+int main(int argc, char *argv[]) {
+  srand((argc > 1) ? atoi(argv[1]) : 1);
+  Compteur emulateur;
+  Minitel minitel(emulateur);
+  minitel.newScreen();
+  minitel.flush();
+  const char* textes[] = { "AB C", "====================", "x", "Minitel", "--  --", "......" };
+  const byte tailles[] = { GRANDEUR_NORMALE, DOUBLE_HAUTEUR, DOUBLE_LARGEUR, DOUBLE_GRANDEUR };
+  byte taille = GRANDEUR_NORMALE;
+  boolean texte = true;
+  unsigned long total = 0, totalAncien = 0, exceptions = 0;
+  for (int k=0; k<APPELS; k++) {
+    int x = 1 + rand()%40, y = 1 + rand()%24;
+    int x2 = x + rand()%(41-x), y2 = y + rand()%(25-y);
+    int ancien = -1;  // Pas de comparaison
+    int tolerance = 0;
+    boolean largeur = (taille == DOUBLE_LARGEUR || taille == DOUBLE_GRANDEUR);  // Pour vLine et rect, qui passent en mode texte
+    boolean deplacement = false;  // Le curseur doit finir en x,y.
+    int mosaique = -1;  // graphic(mosaique, x, y)
+    unsigned long avant = emulateur.octets;
+    switch (rand()%10) {
+      case 0 :
+      case 1 :
+        minitel.moveCursorXY(x,y);
+        ancien = ancienXY(x,y);
+        deplacement = true;
+        break;
+      case 2 : {
+        const char* t = textes[rand()%6];
+        minitel.print(t);
+        ancien = strlen(t);
+        break;
+      }
+      case 3 :
+        mosaique = rand()%64;
+        minitel.graphic(mosaique, x, y);
+        ancien = ancienXY(x,y) + 1;
+        break;
+      case 4 :
+        if (x2 == x) break;
+        minitel.hLine(x, y, x2, CENTER);
+        ancien = ancienHLine(x,y);
+        texte = true;
+        break;
+      case 5 : {
+        if (y2 == y) break;
+        int sens = (rand()%2) ? UP : DOWN;
+        minitel.vLine(x, y, y2, LEFT, sens);
+        ancien = ancienVLine(x, y, y2, sens);
+        if (largeur) tolerance = y2 - y;
+        texte = true;
+        break;
+      }
+      case 6 :
+        if (x2 == x || y2 <= y+1) break;
+        minitel.rect(x, y, x2, y2);
+        ancien = ancienHLine(x,y) + ancienVLine(x2, y+1, y2, DOWN)
+               + ancienHLine(x,y2) + ancienVLine(x, y, y2-1, UP);
+        if (largeur) tolerance = 2 * (y2 - y - 1);
+        deplacement = true;  // rect finit dans le coin supérieur gauche.
+        texte = true;
+        break;
+      case 7 :
+        if (!texte) break;
+        taille = tailles[rand()%4];
+        minitel.attributs(taille);
+        ancien = (taille == DOUBLE_HAUTEUR || taille == DOUBLE_GRANDEUR) ? 3 : 2;  // ESC, attribut, LF
+        break;
+      case 8 :
+        minitel.textMode();
+        ancien = 1;
+        texte = true;
+        break;
+      case 9 :
+        minitel.graphicMode();
+        ancien = 1;
+        texte = false;
+        break;
+    }
+    minitel.flush();
+    int octets = (int) (emulateur.octets - avant);
+    if (ancien < 0) continue;
+    total += octets;
+    totalAncien += ancien;
+    if (octets > ancien) exceptions++;
+    if (octets > ancien + tolerance) {
+      printf("Appel %d : %d octets au lieu de %d au plus\n", k, octets, ancien + tolerance);
+      return 1;
+    }
+    if (mosaique >= 0 && emulateur.getCell(x,y).code != minitel.getGraphicByte(mosaique)) {
+      printf("Appel %d : mosaïque absente de la case %d,%d\n", k, x, y);
+      return 1;
+    }
+    if (deplacement && (emulateur.cursorX() != x || emulateur.cursorY() != y)) {
+      printf("Appel %d : curseur en %d,%d au lieu de %d,%d\n", k, emulateur.cursorX(), emulateur.cursorY(), x, y);
+      return 1;
+    }
+  }
+  printf("%d appels : %lu octets (ancienne version : %lu, soit %.1f %% de moins)\n",
+         APPELS, total, totalAncien, 100.0 * (totalAncien - total) / totalAncien);
+  printf("Doubles largeurs plus coûteuses (vLine, rect) : %lu appels\n", exceptions);
+  return 0;
+}
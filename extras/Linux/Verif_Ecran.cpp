@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////
+/*
+   Verif_Ecran - Version du 17 octobre 2026
+   Copyright 2016-2026 - Eric Sérandour
+
+   Vérifie, avec MinitelEmulator, que les octets émis par la bibliothèque
+   donnent bien l'écran attendu :
+   - Optimisations : des dessins tirés au hasard (attributs, texte,
+     mosaïques, déplacements, figures) sont envoyés à deux émulateurs,
+     une fois normalement, une fois sans répétition automatique (REP) et
+     avec curseur et attributs déclarés inconnus avant chaque appel (tout
+     est alors envoyé en entier). Les deux écrans doivent être identiques.
+   - Ecran virtuel : des grilles tirées au hasard sont dessinées dans un
+     MinitelScreen, dont commit() doit reproduire chaque case sur
+     l'émulateur (tailles normales seulement : un caractère double en
+     partie recouvert n'a pas d'équivalent Vidéotex).
+   - Conversion UTF-8 : un texte accentué doit se relire à l'identique.
+   Le programme renvoie 1 si une vérification échoue.
+
+   Compilation (depuis la racine de la bibliothèque) :
+   g++ -O2 -I. Minitel1B_Soft.cpp Minitel1B_Host.cpp Minitel1B_Screen.cpp Minitel1B_Emulator.cpp extras/Linux/Verif_Ecran.cpp -o verif_ecran
+
+   Utilisation :
+   ./verif_ecran [graine]
+
+////////////////////////////////////////////////////////////////////////
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program. If not, see <http://www.gnu.org/licenses/>.
+*/
+////////////////////////////////////////////////////////////////////////
+
+#include "Minitel1B_Emulator.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+const int DESSINS = 2000;  // Dessins comparés
+const int APPELS = 100;    // Appels par dessin
+const int GRILLES = 200;   // Grilles de l'écran virtuel
+
+// Dessin tiré au hasard à partir de graine. Avec complet, rien n'est
+// optimisé : chaque appel part d'un curseur et d'attributs inconnus.
+static void dessiner(Minitel& minitel, unsigned int graine, boolean complet) {
+  const char* textes[] = { "AB C", "====", "x", "Déjà été", "--  --", "......", "œuvre" };
+  const byte attributs[] = {
+    CARACTERE_ROUGE, CARACTERE_BLANC, FOND_BLEU, FOND_NOIR, CLIGNOTEMENT, FIXE,
+    MASQUAGE, DEMASQUAGE, DEBUT_LIGNAGE, FIN_LIGNAGE, INVERSION_FOND, FOND_NORMAL,
+    GRANDEUR_NORMALE, DOUBLE_HAUTEUR, DOUBLE_LARGEUR, DOUBLE_GRANDEUR
+  };
+  srand(graine);
+  minitel.setAutoRepeat(!complet);
+  minitel.newScreen();
+  for (int k=0; k<APPELS; k++) {
+    int x = 1 + rand()%40, y = 1 + rand()%24;
+    int x2 = x + rand()%(41-x), y2 = y + rand()%(25-y);
+    if (complet) {
+      minitel.invalidateCursor();
+      minitel.invalidateAttributes();
+    }
+    switch (rand()%14) {
+      case 0 : minitel.moveCursorXY(x,y); break;
+      case 1 : minitel.newXY(x,y); break;
+      case 2 : case 3 : minitel.attributs(attributs[rand()%16]); break;
+      case 4 : case 5 : minitel.print(textes[rand()%7]); break;
+      case 6 : minitel.graphic(rand()%64, x, y); break;
+      case 7 : minitel.textMode(); break;
+      case 8 : minitel.graphicMode(); break;
+      case 9 : if (x2 > x) minitel.hLine(x, y, x2, CENTER); break;
+      case 10 : if (y2 > y) minitel.vLine(x, y, y2, RIGHT, (rand()%2) ? UP : DOWN); break;
+      case 11 : if (x2 > x && y2 > y+1) minitel.rect(x, y, x2, y2); break;
+      case 12 : if (x2 > x+1 && y2 > y+1) minitel.panel(x, y, x2, y2, "Titre"); break;
+      case 13 : if (rand()%2) minitel.fillRect(x, y, x2, y2); else minitel.clearRect(x, y, x2, y2); break;
+    }
+  }
+  minitel.flush();
+}
+
+static boolean verifierOptimisations(unsigned int graine) {
+  for (int i=0; i<DESSINS; i++) {
+    MinitelEmulator optimise, complet;
+    Minitel a(optimise), b(complet);
+    dessiner(a, graine + i, false);
+    dessiner(b, graine + i, true);
+    if (!optimise.sameScreen(complet)) {
+      printf("Optimisations : écrans différents (dessin %u)\n", graine + i);
+      for (int y=0; y<MINITEL_RANGEES; y++) {
+        if (optimise.row(y) != complet.row(y)) {
+          printf("%2d optimisé : %s\n%2d complet  : %s\n", y, optimise.row(y).c_str(), y, complet.row(y).c_str());
+        }
+      }
+      return false;
+    }
+  }
+  printf("Optimisations : %d dessins identiques\n", DESSINS);
+  return true;
+}
+
+static boolean verifierEcranVirtuel(unsigned int graine) {
+  MinitelEmulator emulateur;
+  Minitel minitel(emulateur);
+  MinitelScreen ecran(minitel);
+  srand(graine);
+  for (int i=0; i<GRILLES; i++) {
+    for (int k=0; k<300; k++) {
+      int x = 1 + rand()%40, y = rand()%25;
+      MinitelCell c = ecran.getCell(x,y);
+      int r = rand()%10;
+      c.set = (r < 5) ? JEU_G0 : (r < 8) ? JEU_G1 : JEU_G2;
+      c.diacritic = 0;
+      if (c.set == JEU_G0) c.code = 0x20 + rand()%0x5E;
+      else if (c.set == JEU_G1) c.code = minitel.getGraphicByte(rand()%64);
+      else c.code = 0x23 + rand()%3;  // £, $, #
+      if (c.set == JEU_G0 && c.code == 0x60) c.code = 0x61;  // 0x60 n'est pas visualisable en G0
+      c.color = rand()%8;
+      c.background = rand()%8;
+      c.blink = rand()%2;
+      c.mask = rand()%2;
+      c.underline = rand()%2;
+      c.inverse = (c.set == JEU_G1) ? 0 : rand()%2;
+      c.size = 0;
+      ecran.setCell(x, y, c);
+    }
+    ecran.commit();
+    for (int y=0; y<MINITEL_RANGEES; y++) {
+      for (int x=1; x<=MINITEL_COLONNES; x++) {
+        if (ecran.getCell(x,y) != emulateur.getCell(x,y)) {
+          printf("Ecran virtuel : case %d,%d différente (grille %d)\n", x, y, i);
+          return false;
+        }
+      }
+    }
+  }
+  printf("Ecran virtuel : %d grilles identiques\n", GRILLES);
+  return true;
+}
+
+static boolean verifierUtf8() {
+  const char* texte = "Déjà été, noël, œuvre, ½ £ ç";
+  MinitelEmulator emulateur;
+  Minitel minitel(emulateur);
+  minitel.newScreen();
+  minitel.print(texte);
+  minitel.flush();
+  std::string rangee = emulateur.row(1);
+  if (rangee.compare(0, strlen(texte), texte) != 0) {
+    printf("Conversion UTF-8 : %s\n", rangee.c_str());
+    return false;
+  }
+  printf("Conversion UTF-8 : texte relu à l'identique\n");
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  unsigned int graine = (argc > 1) ? atoi(argv[1]) : 1;
+  boolean ok = verifierOptimisations(graine);
+  ok = verifierEcranVirtuel(graine) && ok;
+  ok = verifierUtf8() && ok;
+  return ok ? 0 : 1;
+}